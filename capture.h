@@ -0,0 +1,224 @@
+// Alex Eidt
+// Dino Game - Frame Capture
+
+// Writes the frames the engine reads back to disk from a background thread, so recording a game
+// never waits on the disk. Each frame's pixels are moved into a ring of buffers as it arrives and
+// the writer encodes the ring in order. If the writer falls so far behind that the ring is full,
+// the new frame is dropped and counted, unless the capture was opened to wait for a free buffer.
+//
+// A path ending in ".y4m" is written as YUV4MPEG2 video: 4:2:0, full range BT.601 at a nominal
+// CAPTURE_FPS, tagged XCOLORRANGE=FULL so players do not assume limited range, with every frame
+// cropped or padded with black to the size of the first. Any other path is written as raw RGBA
+// frames back to back, with a text index at "path.idx" that holds one "frame offset width height"
+// line per frame, the offset being in bytes.
+
+#pragma once
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "olcPixelGameEngine.h"
+
+#define CAPTURE_BUFFERS 16 // Frames that can wait for the writer before new ones are dropped.
+#define CAPTURE_FPS 60 // Frame rate written to Y4M headers.
+
+namespace dino {
+	class FrameWriter {
+	public:
+		~FrameWriter() {
+			Close();
+		}
+
+		// Start writing frames to "path". With "wait", Push waits for a free buffer instead of
+		// dropping the frame, for runs that are not paced by a clock.
+		void Open(const std::string& path, bool wait) {
+			y4m = path.size() >= 4 && path.compare(path.size() - 4, 4, ".y4m") == 0;
+			file.open(path, std::ios::binary);
+			if (!file.is_open()) throw std::runtime_error("Failed to open capture for writing: " + path);
+			if (!y4m) {
+				index.open(path + ".idx");
+				if (!index.is_open()) throw std::runtime_error("Failed to open capture index for writing: " + path + ".idx");
+			}
+
+			this->wait = wait;
+			ring.assign(CAPTURE_BUFFERS, Frame());
+			first = 0;
+			queued = 0;
+			written = 0;
+			dropped = 0;
+			offset = 0;
+			quit = false;
+			writer = std::thread(&FrameWriter::Writer, this);
+		}
+
+		bool IsOpen() const {
+			return writer.joinable();
+		}
+
+		// Queue "frame" for writing by taking its pixels. The sprite is left with a buffer of the
+		// same size to be read into next. Frames must all be pushed from the same thread.
+		void Push(olc::Sprite* frame) {
+			if (!IsOpen()) return;
+			size_t slot;
+			{
+				std::unique_lock<std::mutex> lock(mutex);
+				if (wait) {
+					space.wait(lock, [&] { return queued < ring.size(); });
+				} else if (queued == ring.size()) {
+					dropped++;
+					return;
+				}
+				slot = (first + queued) % ring.size();
+			}
+
+			// The writer never touches a slot until it is queued, so it is filled without the lock.
+			Frame& buffer = ring[slot];
+			buffer.width = frame->width;
+			buffer.height = frame->height;
+			buffer.pixels.swap(frame->pColData);
+			frame->pColData.resize(size_t(frame->width) * size_t(frame->height));
+
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				queued++;
+			}
+			ready.notify_one();
+		}
+
+		// Write out every queued frame and close the files. Returns false if any write failed.
+		bool Close() {
+			if (!IsOpen()) return true;
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				quit = true;
+			}
+			ready.notify_one();
+			writer.join();
+
+			bool ok = file.good() && (y4m || index.good());
+			file.close();
+			if (index.is_open()) index.close();
+			return ok;
+		}
+
+		uint64_t Written() const {
+			return written;
+		}
+
+		uint64_t Dropped() const {
+			return dropped;
+		}
+
+	private:
+		struct Frame {
+			int width = 0;
+			int height = 0;
+			std::vector<olc::Pixel> pixels;
+		};
+
+		std::ofstream file;
+		std::ofstream index;
+		bool y4m = false;
+		bool wait = false;
+
+		// Frames [first, first + queued) of the ring are waiting for the writer.
+		std::vector<Frame> ring;
+		size_t first = 0;
+		size_t queued = 0;
+		bool quit = false;
+		std::mutex mutex;
+		std::condition_variable ready;
+		std::condition_variable space;
+		std::thread writer;
+
+		uint64_t written = 0;
+		uint64_t dropped = 0;
+		uint64_t offset = 0; // Bytes written to a raw capture.
+
+		// Size of a Y4M capture, taken from its first frame.
+		int width = 0;
+		int height = 0;
+		std::vector<uint8_t> planes;
+
+		void Writer() {
+			std::unique_lock<std::mutex> lock(mutex);
+			while (true) {
+				ready.wait(lock, [&] { return queued > 0 || quit; });
+				if (queued == 0) return;
+				Frame& frame = ring[first];
+				lock.unlock();
+
+				if (y4m) WriteY4M(frame);
+				else WriteRaw(frame);
+				written++;
+
+				lock.lock();
+				first = (first + 1) % ring.size();
+				queued--;
+				space.notify_one();
+			}
+		}
+
+		void WriteRaw(const Frame& frame) {
+			uint64_t bytes = uint64_t(frame.pixels.size()) * sizeof(olc::Pixel);
+			index << written << ' ' << offset << ' ' << frame.width << ' ' << frame.height << '\n';
+			file.write((const char*)frame.pixels.data(), std::streamsize(bytes));
+			offset += bytes;
+		}
+
+		void WriteY4M(const Frame& frame) {
+			if (written == 0) {
+				width = frame.width;
+				height = frame.height;
+				file << "YUV4MPEG2 W" << width << " H" << height << " F" << CAPTURE_FPS << ":1 Ip A1:1 C420jpeg XCOLORRANGE=FULL\n";
+			}
+
+			int chromaWidth = (width + 1) / 2;
+			int chromaHeight = (height + 1) / 2;
+			size_t lumaSize = size_t(width) * size_t(height);
+			size_t chromaSize = size_t(chromaWidth) * size_t(chromaHeight);
+			planes.assign(lumaSize + 2 * chromaSize, 0);
+			uint8_t* luma = planes.data();
+			uint8_t* cb = luma + lumaSize;
+			uint8_t* cr = cb + chromaSize;
+
+			// Pixels outside the frame are black, which is also where the planes start.
+			int w = std::min(width, frame.width);
+			int h = std::min(height, frame.height);
+			for (int y = 0; y < h; y++) {
+				const olc::Pixel* row = frame.pixels.data() + size_t(y) * frame.width;
+				uint8_t* out = luma + size_t(y) * width;
+				for (int x = 0; x < w; x++) {
+					out[x] = uint8_t((77 * row[x].r + 150 * row[x].g + 29 * row[x].b + 128) >> 8);
+				}
+			}
+
+			// Each chroma sample is taken from the average of the 2x2 pixels it covers.
+			std::fill(cb, cb + 2 * chromaSize, uint8_t(128));
+			for (int cy = 0; cy < (h + 1) / 2; cy++) {
+				const olc::Pixel* row0 = frame.pixels.data() + size_t(2 * cy) * frame.width;
+				const olc::Pixel* row1 = frame.pixels.data() + size_t(std::min(2 * cy + 1, h - 1)) * frame.width;
+				for (int cx = 0; cx < (w + 1) / 2; cx++) {
+					int x0 = 2 * cx;
+					int x1 = std::min(x0 + 1, w - 1);
+					int r = row0[x0].r + row0[x1].r + row1[x0].r + row1[x1].r;
+					int g = row0[x0].g + row0[x1].g + row1[x0].g + row1[x1].g;
+					int b = row0[x0].b + row0[x1].b + row1[x0].b + row1[x1].b;
+					size_t i = size_t(cy) * chromaWidth + cx;
+					cb[i] = uint8_t(std::min((-43 * r - 85 * g + 128 * b + (128 << 10) + 512) >> 10, 255));
+					cr[i] = uint8_t(std::min((128 * r - 107 * g - 21 * b + (128 << 10) + 512) >> 10, 255));
+				}
+			}
+
+			file.write("FRAME\n", 6);
+			file.write((const char*)planes.data(), std::streamsize(planes.size()));
+		}
+	};
+}
@@ -0,0 +1,737 @@
+// Alex Eidt
+// Dino Game - Simulation
+
+// The game rules, kept apart from rendering and audio. The simulation only ever advances in fixed
+// steps of STEP_TIME seconds, so gameplay does not depend on the frame rate it is displayed at.
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#endif
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+#include "sprites.h"
+
+#define PLAYER_POSITION 60.0f
+#define JUMP_MULTIPLIER 15
+#define JUMP_DURATION 0.75f // Jump duration in seconds.
+#define GROUND_SPEED 500.0f
+#define MAX_GROUND_SPEED 1500.0f
+#define CLOUD_SPEED 150.0f
+
+// Simulation.
+#define STEP_RATE 240
+#define STEP_TIME (1.0f / STEP_RATE)
+#define ANIMATION_STEPS 24 // Animation and score update every 0.1 seconds.
+#define FLAP_STEPS 40 // Pteranodons flap their wings every 1/6 seconds.
+#define ENEMY_CHANCE 800 // An enemy spawn is attempted with a chance of 1 in ENEMY_CHANCE per step.
+#define CLOUD_CHANCE 4000 // A cloud spawn is attempted with a chance of 1 in CLOUD_CHANCE per step.
+#define MAX_ENEMIES 32 // Enemies on screen at once, about 20 at most in practice. Must be a power of two.
+#define MAX_CLOUDS 8 // Must be a power of two.
+
+namespace dino {
+	// Events raised during a step, for the caller to play sounds.
+	enum Event : uint32_t {
+		EVENT_NONE = 0,
+		EVENT_JUMP = 1 << 0,
+		EVENT_SCORE = 1 << 1,
+		EVENT_GAMEOVER = 1 << 2
+	};
+
+	// Key presses delivered to a step.
+	struct Input {
+		bool jump = false; // SPACE pressed.
+		bool duck = false; // DOWN pressed.
+		bool stand = false; // DOWN released.
+	};
+
+	// xoshiro128** pseudo random number generator. Small, fast and owned by each game, so games on
+	// different threads never share state and a seed always reproduces the same sequence.
+	class Random {
+	public:
+		Random(uint64_t seed = 0) {
+			Seed(seed);
+		}
+
+		// Expand a 64 bit seed into the full state with splitmix64, which never yields an all zero state.
+		void Seed(uint64_t seed) {
+			for (int i = 0; i < 4; i += 2) {
+				seed += 0x9E3779B97F4A7C15ull;
+				uint64_t z = seed;
+				z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+				z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+				z ^= z >> 31;
+				state[i] = uint32_t(z);
+				state[i + 1] = uint32_t(z >> 32);
+			}
+		}
+
+		uint32_t Next() {
+			uint32_t result = Rotl(state[1] * 5, 7) * 9;
+			uint32_t t = state[1] << 9;
+			state[2] ^= state[0];
+			state[3] ^= state[1];
+			state[1] ^= state[2];
+			state[0] ^= state[3];
+			state[2] ^= t;
+			state[3] = Rotl(state[3], 11);
+			return result;
+		}
+
+		// Uniform integer in [0, n). Uses a multiply and shift rather than a division. The bias is
+		// below n / 2^32, far too small to matter for the game.
+		uint32_t Range(uint32_t n) {
+			return uint32_t((uint64_t(Next()) * n) >> 32);
+		}
+
+	private:
+		uint32_t state[4];
+
+		static uint32_t Rotl(uint32_t x, int k) {
+			return (x << k) | (x >> (32 - k));
+		}
+	};
+
+	// O------------------------------------------------------------------------------O
+	// | Collision masks                                                              |
+	// O------------------------------------------------------------------------------O
+
+	// One bit per pixel of a sprite, set where the sprite is opaque. Each row is padded with a
+	// zero word, so a 64 pixel window can be read from any column inside the sprite.
+	class CollisionMask {
+	public:
+		CollisionMask() = default;
+
+		// Build from "width" x "height" pixels of RGBA data, 4 bytes per pixel and "stride" pixels per row.
+		CollisionMask(int width, int height, const uint8_t* rgba, int stride) : width(width), height(height) {
+			words = (width + 63) / 64 + 1;
+			bits.assign(size_t(words) * height, 0);
+			for (int row = 0; row < height; row++) {
+				for (int col = 0; col < width; col++) {
+					if (rgba[(size_t(row) * stride + col) * 4 + 3] >= 128) {
+						bits[size_t(row) * words + col / 64] |= uint64_t(1) << (col % 64);
+					}
+				}
+			}
+		}
+
+		bool empty() const {
+			return bits.empty();
+		}
+
+		// Pixels "col" to "col" + 63 of "row", lowest bit first. Pixels past the right edge read as 0.
+		uint64_t Bits(int row, int col) const {
+			const uint64_t* line = bits.data() + size_t(row) * words + col / 64;
+			int shift = col % 64;
+			if (shift == 0) return line[0];
+			return (line[0] >> shift) | (line[1] << (64 - shift));
+		}
+
+		// Whether this mask drawn at (x, y) shares an opaque pixel with "other" drawn at (ox, oy).
+		bool Overlaps(int x, int y, const CollisionMask& other, int ox, int oy) const {
+			int x0 = std::max(x, ox), x1 = std::min(x + width, ox + other.width);
+			int y0 = std::max(y, oy), y1 = std::min(y + height, oy + other.height);
+			for (int row = y0; row < y1; row++) {
+				for (int col = x0; col < x1; col += 64) {
+					if (Bits(row - y, col - x) & other.Bits(row - oy, col - ox)) return true;
+				}
+			}
+			return false;
+		}
+
+	private:
+		int width = 0;
+		int height = 0;
+		int words = 0; // 64 bit words per row.
+		std::vector<uint64_t> bits;
+	};
+
+	// Whether a sprite can take part in a collision: the running and ducking dino and every enemy.
+	constexpr bool Collidable(int sprite) {
+		return (sprite >= SPRITE_DINO_1 && sprite <= SPRITE_DINO_8) ||
+			(sprite >= SPRITE_CACTUS_1 && sprite <= SPRITE_CACTUS_9) ||
+			(sprite >= SPRITE_PTERANODON_1 && sprite <= SPRITE_PTERANODON_2);
+	}
+
+	// Everything about the play field that stays fixed for a game, worked out once from the screen size.
+	struct World {
+		int screenWidth = 0;
+		int screenHeight = 0;
+		int dinoBottom = 0; // Bottom edge of the dino while it stands on the ground.
+		int cactusBottom = 0; // Bottom edge of every cactus.
+		int lowPteranodonY = 0;
+		int highPteranodonY = 0;
+		int cloudMinY = 0; // Clouds are placed with their top edge in [cloudMinY, cloudMaxY).
+		int cloudMaxY = 0;
+
+		// Collision masks indexed by Sprite. Without masks, collisions use the sprite hitboxes alone.
+		std::vector<CollisionMask> masks;
+
+		World() = default;
+
+		World(int width, int height) : screenWidth(width), screenHeight(height) {
+			// All standing dino sprites have the same dimensions.
+			int dinoHeight = Info(SPRITE_DINO_1).height;
+			int dinoDuckHeight = Info(SPRITE_DINO_7).height;
+			int cloudHeight = Info(SPRITE_CLOUD).height;
+			dinoBottom = screenHeight - 8;
+			cactusBottom = screenHeight - 4;
+			// A low flyer must be ducked under, a high flyer can be run under.
+			lowPteranodonY = (screenHeight - dinoHeight - 8) - dinoDuckHeight;
+			highPteranodonY = screenHeight - 2 * dinoHeight - 8 - 8;
+			cloudMinY = cloudHeight + 10;
+			cloudMaxY = screenHeight - cloudHeight - dinoHeight - 8;
+		}
+
+		// Set the collision mask of "sprite" from its RGBA pixels, "stride" pixels per row. Sprites that
+		// are not Collidable are ignored.
+		void SetMask(int sprite, const uint8_t* rgba, int stride) {
+			if (!Collidable(sprite)) return;
+			masks.resize(SPRITE_COUNT);
+			masks[sprite] = CollisionMask(Info(sprite).width, Info(sprite).height, rgba, stride);
+		}
+	};
+
+	// O------------------------------------------------------------------------------O
+	// | Enemy storage                                                                |
+	// O------------------------------------------------------------------------------O
+
+	// Kernels over arrays of enemy coordinates. These use the widest vectors the compiler targets
+	// (AVX, then SSE2) and finish the remainder one at a time. Every lane does exactly the float
+	// operations of the scalar code, so results never depend on the instruction set, and replays
+	// recorded on one machine play back on any other.
+	namespace simd {
+		// x[i] -= dx for "n" values.
+		inline void Subtract(float* x, int n, float dx) {
+			int i = 0;
+#if defined(__AVX__)
+			__m256 d8 = _mm256_set1_ps(dx);
+			for (; i + 8 <= n; i += 8) {
+				_mm256_storeu_ps(x + i, _mm256_sub_ps(_mm256_loadu_ps(x + i), d8));
+			}
+#endif
+#if defined(__AVX__) || defined(__SSE2__) || defined(_M_X64)
+			__m128 d4 = _mm_set1_ps(dx);
+			for (; i + 4 <= n; i += 4) {
+				_mm_storeu_ps(x + i, _mm_sub_ps(_mm_loadu_ps(x + i), d4));
+			}
+#endif
+			for (; i < n; i++) {
+				x[i] -= dx;
+			}
+		}
+
+		// Bit i is set if box i of the "n" (at most 32) boxes (x, y, width, height) overlaps the box
+		// from (x0, y0) to (x1, y1). Boxes that only touch along an edge count as overlapping.
+		inline uint32_t Overlapping(const float* x, const float* y, const float* w, const float* h, int n,
+			float x0, float y0, float x1, float y1) {
+			uint32_t hits = 0;
+			int i = 0;
+#if defined(__AVX__)
+			__m256 bx0 = _mm256_set1_ps(x0), by0 = _mm256_set1_ps(y0);
+			__m256 bx1 = _mm256_set1_ps(x1), by1 = _mm256_set1_ps(y1);
+			for (; i + 8 <= n; i += 8) {
+				__m256 ex0 = _mm256_loadu_ps(x + i);
+				__m256 ey0 = _mm256_loadu_ps(y + i);
+				__m256 ex1 = _mm256_add_ps(ex0, _mm256_loadu_ps(w + i));
+				__m256 ey1 = _mm256_add_ps(ey0, _mm256_loadu_ps(h + i));
+				__m256 hit = _mm256_and_ps(
+					_mm256_and_ps(_mm256_cmp_ps(ex0, bx1, _CMP_LE_OQ), _mm256_cmp_ps(bx0, ex1, _CMP_LE_OQ)),
+					_mm256_and_ps(_mm256_cmp_ps(ey0, by1, _CMP_LE_OQ), _mm256_cmp_ps(by0, ey1, _CMP_LE_OQ))
+				);
+				hits |= uint32_t(_mm256_movemask_ps(hit)) << i;
+			}
+#endif
+#if defined(__AVX__) || defined(__SSE2__) || defined(_M_X64)
+			__m128 cx0 = _mm_set1_ps(x0), cy0 = _mm_set1_ps(y0);
+			__m128 cx1 = _mm_set1_ps(x1), cy1 = _mm_set1_ps(y1);
+			for (; i + 4 <= n; i += 4) {
+				__m128 ex0 = _mm_loadu_ps(x + i);
+				__m128 ey0 = _mm_loadu_ps(y + i);
+				__m128 ex1 = _mm_add_ps(ex0, _mm_loadu_ps(w + i));
+				__m128 ey1 = _mm_add_ps(ey0, _mm_loadu_ps(h + i));
+				__m128 hit = _mm_and_ps(
+					_mm_and_ps(_mm_cmple_ps(ex0, cx1), _mm_cmple_ps(cx0, ex1)),
+					_mm_and_ps(_mm_cmple_ps(ey0, cy1), _mm_cmple_ps(cy0, ey1))
+				);
+				hits |= uint32_t(_mm_movemask_ps(hit)) << i;
+			}
+#endif
+			for (; i < n; i++) {
+				// Rectangular Bounding Box Method.
+				bool noOverlap = x[i] > x1 || x0 > x[i] + w[i] || y[i] > y1 || y0 > y[i] + h[i];
+				if (!noOverlap) hits |= uint32_t(1) << i;
+			}
+			return hits;
+		}
+	}
+
+	// Fixed-capacity first in, first out queue. Items are added at the back and retired from the
+	// front without moving the others, and nothing is allocated after construction. "Capacity"
+	// must be a power of two.
+	template <typename T, int Capacity>
+	class Ring {
+		static_assert((Capacity & (Capacity - 1)) == 0, "Ring capacity must be a power of two");
+
+	public:
+		int size() const {
+			return count;
+		}
+
+		bool empty() const {
+			return count == 0;
+		}
+
+		bool full() const {
+			return count == Capacity;
+		}
+
+		void clear() {
+			head = 0;
+			count = 0;
+		}
+
+		// Items in the order they were added, from 0 (the front) to size() - 1 (the back).
+		T& operator[](int i) {
+			return items[(head + i) & (Capacity - 1)];
+		}
+
+		const T& operator[](int i) const {
+			return items[(head + i) & (Capacity - 1)];
+		}
+
+		T& back() {
+			return (*this)[count - 1];
+		}
+
+		// Returns false, and drops the item, when the ring is full.
+		bool push_back(const T& item) {
+			if (full()) return false;
+			(*this)[count++] = item;
+			return true;
+		}
+
+		void pop_front(int n = 1) {
+			head = (head + n) & (Capacity - 1);
+			count -= n;
+		}
+
+	private:
+		T items[Capacity];
+		int head = 0;
+		int count = 0;
+	};
+
+	// Enemies on screen, stored as one array per field so the movement and collision kernels run
+	// over contiguous floats. The arrays form a ring: enemies enter at the back and, since they all
+	// move left at the same speed, leave from the front. Slot(i) maps the i'th enemy from the left
+	// to its place in the arrays, and the occupied slots are at most two contiguous spans.
+	class EnemyList {
+	public:
+		float x[MAX_ENEMIES];
+		float y[MAX_ENEMIES];
+		float width[MAX_ENEMIES];
+		float height[MAX_ENEMIES];
+		float prevX[MAX_ENEMIES]; // Positions before the last step, used to interpolate rendering.
+		int sprite[MAX_ENEMIES];
+
+		int size() const {
+			return count;
+		}
+
+		bool empty() const {
+			return count == 0;
+		}
+
+		void clear() {
+			head = 0;
+			count = 0;
+		}
+
+		int Slot(int i) const {
+			return (head + i) & (MAX_ENEMIES - 1);
+		}
+
+		// Add an enemy at the back. When the list is full the enemy is not added.
+		void Add(int enemySprite, float ex, float ey) {
+			if (count == MAX_ENEMIES) return;
+			int i = Slot(count++);
+			x[i] = ex;
+			y[i] = ey;
+			width[i] = float(Info(enemySprite).width);
+			height[i] = float(Info(enemySprite).height);
+			prevX[i] = ex;
+			sprite[i] = enemySprite;
+		}
+
+		// Remember the current positions as the ones to interpolate from.
+		void SavePositions() {
+			for (int k = 0; k < 2; k++) {
+				int start, n;
+				Span(k, start, n);
+				std::copy(x + start, x + start + n, prevX + start);
+			}
+		}
+
+		// Move every enemy "dx" pixels to the left.
+		void Advance(float dx) {
+			for (int k = 0; k < 2; k++) {
+				int start, n;
+				Span(k, start, n);
+				simd::Subtract(x + start, n, dx);
+			}
+		}
+
+		// Drop the enemies that have moved entirely off the left of the screen.
+		void RemoveOffscreen() {
+			while (count > 0 && x[head] < -width[head]) {
+				head = (head + 1) & (MAX_ENEMIES - 1);
+				count--;
+			}
+		}
+
+		// Bit i is set if the enemy in slot i overlaps the box from (x0, y0) to (x1, y1).
+		uint32_t Overlapping(float x0, float y0, float x1, float y1) const {
+			uint32_t hits = 0;
+			for (int k = 0; k < 2; k++) {
+				int start, n;
+				Span(k, start, n);
+				hits |= simd::Overlapping(x + start, y + start, width + start, height + start, n, x0, y0, x1, y1) << start;
+			}
+			return hits;
+		}
+
+	private:
+		int head = 0;
+		int count = 0;
+
+		// The k'th (0 or 1) contiguous run of occupied slots. The second is empty unless the ring wraps.
+		void Span(int k, int& start, int& n) const {
+			int first = std::min(count, MAX_ENEMIES - head);
+			start = k == 0 ? head : 0;
+			n = k == 0 ? first : count - first;
+		}
+	};
+
+	struct Cloud {
+		float x;
+		float y;
+		float prevX;
+	};
+
+	// O------------------------------------------------------------------------------O
+	// | Game rules, shared by every kind of game state                               |
+	// O------------------------------------------------------------------------------O
+
+	// Height of the dino above the ground "jumpTimer" seconds into a jump, drawn with sprite "dinoIndex".
+	// Use a parabola to model the dinosaur jump. y = -a * (x^2 - b*x).
+	inline float JumpHeight(int dinoIndex, float jumpTimer) {
+		int maxJumpHeight = Info(SPRITE_DINO_0 + dinoIndex).height * JUMP_MULTIPLIER;
+		return -maxJumpHeight * (jumpTimer * jumpTimer - JUMP_DURATION * jumpTimer);
+	}
+
+	// Top of the dino sprite for a given jump height.
+	inline float DinoY(const World& world, int dinoIndex, float jumpHeight) {
+		return std::max(world.dinoBottom - Info(SPRITE_DINO_0 + dinoIndex).height - jumpHeight, 0.0f);
+	}
+
+	// Move enemies "dx" pixels to the left and drop the ones that have left the screen.
+	inline void MoveEnemies(EnemyList& enemies, float dx) {
+		enemies.Advance(dx);
+		enemies.RemoveOffscreen();
+	}
+
+	// Whether a new enemy can be placed at the right edge of the screen without overlapping the last one.
+	inline bool HasRoom(const World& world, const EnemyList& enemies, int jumpLength) {
+		if (enemies.empty()) return true;
+		int last = enemies.Slot(enemies.size() - 1);
+		return enemies.x[last] < world.screenWidth - int(enemies.width[last]) - jumpLength;
+	}
+
+	inline void AddCactus(const World& world, EnemyList& enemies, int index, int offset) {
+		int sprite = SPRITE_CACTUS_1 + index - 1;
+		enemies.Add(sprite, float(world.screenWidth + offset), float(world.cactusBottom - Info(sprite).height));
+	}
+
+	inline void AddPteranodon(const World& world, Random& rng, EnemyList& enemies, float groundSpeed) {
+		// For the Pteranodon, choose between a low flyer and a high flyer.
+		int y = rng.Range(2) ? world.lowPteranodonY : world.highPteranodonY;
+		int index = rng.Range(2) + 1;
+
+		int jumpLength = JUMP_DURATION * groundSpeed;
+		if (HasRoom(world, enemies, jumpLength)) {
+			enemies.Add(SPRITE_PTERANODON_1 + index - 1, float(world.screenWidth), float(y));
+		}
+	}
+
+	inline void AddCactus(const World& world, Random& rng, EnemyList& enemies, float groundSpeed) {
+		if (enemies.empty()) {
+			AddCactus(world, enemies, rng.Range(8) + 1, 0); // Randomly choose any cactus other than "cactus_9".
+			return;
+		}
+
+		int jumpLength = JUMP_DURATION * groundSpeed;
+		if (!HasRoom(world, enemies, jumpLength)) return;
+
+		int index = rng.Range(9) + 1;
+		// "cactus_9" is the largest cactus sprite.
+		// If we choose this cactus, then we only draw one sprite.
+		if (index == 9 && Info(SPRITE_CACTUS_9).width <= jumpLength) {
+			AddCactus(world, enemies, 9, 0);
+		} else {
+			int offset = 0;
+			// Add 1-4 cactuses in a row.
+			for (int i = 0; (i < int(rng.Range(4)) + 1) && offset <= jumpLength; i++) {
+				int index = rng.Range(8) + 1;
+				AddCactus(world, enemies, index, offset);
+				offset += Info(SPRITE_CACTUS_1 + index - 1).width;
+			}
+		}
+	}
+
+	// Randomly add enemies. Wait until the user has a score of 25 to add enemies.
+	inline void SpawnEnemies(const World& world, Random& rng, EnemyList& enemies, float groundSpeed, int score) {
+		if (score >= 25 && rng.Range(ENEMY_CHANCE) == 0) {
+			if (rng.Range(300) > 50) {
+				AddCactus(world, rng, enemies, groundSpeed);
+			} else {
+				AddPteranodon(world, rng, enemies, groundSpeed);
+			}
+		}
+	}
+
+	// Advance the enemies by one step of "dt" seconds: flap the pteranodons every FLAP_STEPS steps,
+	// then move the enemies and maybe spawn a new one. "flapStep" counts steps since the last flap.
+	inline void StepEnemies(const World& world, Random& rng, EnemyList& enemies, int& flapStep, float dt, float groundSpeed, int score) {
+		if (dt > 0.0f && ++flapStep >= FLAP_STEPS) {
+			flapStep = 0;
+			// Flap the wings of the pteranodons.
+			for (int i = 0; i < enemies.size(); i++) {
+				int slot = enemies.Slot(i);
+				if (enemies.sprite[slot] == SPRITE_PTERANODON_1) {
+					enemies.sprite[slot] = SPRITE_PTERANODON_2;
+				} else if (enemies.sprite[slot] == SPRITE_PTERANODON_2) {
+					enemies.sprite[slot] = SPRITE_PTERANODON_1;
+				}
+			}
+		}
+
+		MoveEnemies(enemies, dt * groundSpeed);
+		SpawnEnemies(world, rng, enemies, groundSpeed, score);
+	}
+
+	// Index of the lowest set bit of a non-zero "bits".
+	inline int CountTrailingZeros(uint32_t bits) {
+#if defined(_MSC_VER)
+		unsigned long index;
+		_BitScanForward(&index, bits);
+		return int(index);
+#else
+		return __builtin_ctz(bits);
+#endif
+	}
+
+	// Whether the dino, drawn with sprite "dinoIndex" at "jumpHeight" above the ground, touches any enemy.
+	inline bool Collides(const World& world, int dinoIndex, float jumpHeight, const EnemyList& enemies) {
+		const Rect& box = Info(SPRITE_DINO_0 + dinoIndex).hitbox;
+		float dinoY = DinoY(world, dinoIndex, jumpHeight);
+		float px0 = PLAYER_POSITION + box.x;
+		float py0 = dinoY + box.y;
+		uint32_t hits = enemies.Overlapping(px0, py0, px0 + box.width, py0 + box.height);
+		if (hits == 0 || world.masks.empty()) return hits != 0;
+
+		// Only enemies whose hitbox overlaps the dino get the pixel test. Sprites are compared on whole pixels.
+		const CollisionMask& dinoMask = world.masks[SPRITE_DINO_0 + dinoIndex];
+		int dx = int(std::floor(PLAYER_POSITION)), dy = int(std::floor(dinoY));
+		for (; hits != 0; hits &= hits - 1) {
+			int i = CountTrailingZeros(hits);
+			const CollisionMask& enemyMask = world.masks[enemies.sprite[i]];
+			if (dinoMask.Overlaps(dx, dy, enemyMask, int(std::floor(enemies.x[i])), int(std::floor(enemies.y[i])))) return true;
+		}
+		return false;
+	}
+
+	// O------------------------------------------------------------------------------O
+	// | A single game, as played by DinoGame                                         |
+	// O------------------------------------------------------------------------------O
+
+	class Simulation {
+	public:
+		World world;
+
+		float groundOffset = 0.0f; // Distance the ground has scrolled, wrapped to the ground width.
+		float prevGroundOffset = 0.0f;
+		float groundSpeed = GROUND_SPEED;
+		int animationStep = 0;
+		int flapStep = 0;
+		int dinoIndex = 1; // Dino Sprite to draw.
+
+		float jumpHeight = 0.0f; // Height of the dino above the ground.
+		float prevJumpHeight = 0.0f;
+
+		bool started = false;
+		bool isJumping = false;
+		bool isDucking = false;
+		bool gameOver = false;
+
+		float jumpTimer = 0.0f; // Timer for Dino Jump.
+
+		bool scoreBlinking = false;
+		float scoreTimer = 0.0f;
+
+		int maxScore = 0;
+		int score = 0;
+
+		uint64_t steps = 0; // Number of steps simulated.
+
+		Ring<Cloud, MAX_CLOUDS> clouds;
+		EnemyList enemies;
+
+		Random rng;
+
+		void Init(int width, int height) {
+			world = World(width, height);
+		}
+
+		// Restart the random sequence. Two games with the same seed and input play out identically.
+		void Seed(uint64_t seed) {
+			rng.Seed(seed);
+		}
+
+		// Advance the game by STEP_TIME seconds. Returns the events raised as a combination of "Event" flags.
+		uint32_t Step(const Input& input) {
+			uint32_t events = EVENT_NONE;
+			steps++;
+
+			prevGroundOffset = groundOffset;
+			prevJumpHeight = jumpHeight;
+			for (int i = 0; i < clouds.size(); i++) clouds[i].prevX = clouds[i].x;
+			enemies.SavePositions();
+
+			float dt = gameOver ? 0.0f : STEP_TIME;
+			UpdateScore(dt);
+			UpdateGround(dt);
+			UpdateClouds(dt);
+			StepEnemies(world, rng, enemies, flapStep, dt, groundSpeed, score);
+
+			if (++animationStep >= ANIMATION_STEPS) {
+				animationStep = 0;
+				// Find correct dinosaur sprite to draw based on game variables.
+				if (gameOver) {
+					dinoIndex = 6;
+				} else if (isJumping) {
+					dinoIndex = 1;
+				} else if (isDucking) {
+					dinoIndex = dinoIndex == 7 ? 8 : 7;
+				} else if (started) { // Dinosaur running animation.
+					dinoIndex = dinoIndex == 3 ? 4 : 3;
+				} else { // While the dinosaur is standing, it will randomly blink.
+					dinoIndex = rng.Range(15) ? 1 : 2;
+				}
+
+				// Update score.
+				if (started && !gameOver) {
+					score++;
+					if (score > 0 && score % 100 == 0) events |= EVENT_SCORE;
+				}
+			}
+
+			jumpHeight = JumpHeight(dinoIndex, jumpTimer);
+
+			if (input.jump) {
+				// If space is pressed, start the game.
+				if (!started) {
+					gameOver = false;
+					started = true;
+					enemies.clear();
+				}
+				// If the game is already started, then cause the dinosaur to jump.
+				isJumping = true;
+				if (jumpTimer == 0.0f) events |= EVENT_JUMP;
+			}
+
+			// Wait until the jump is over before the dino can jump again.
+			if (isJumping && !gameOver) {
+				jumpTimer += STEP_TIME;
+				if (jumpTimer > JUMP_DURATION) {
+					isJumping = false;
+					jumpTimer = 0.0f;
+				}
+			}
+
+			// If down arrow is pressed, duck the dinosaur.
+			if (input.duck && started) isDucking = true;
+			if (input.stand) isDucking = false;
+
+			if (!gameOver && Collides(world, dinoIndex, jumpHeight, enemies)) {
+				gameOver = true;
+				started = false;
+				maxScore = std::max(maxScore, score);
+				score = 0;
+				scoreTimer = 0;
+				scoreBlinking = false;
+				groundSpeed = GROUND_SPEED;
+				events |= EVENT_GAMEOVER;
+			}
+
+			return events;
+		}
+
+		// Top of the dino sprite for a given jump height.
+		float DinoY(float height) const {
+			return dino::DinoY(world, dinoIndex, height);
+		}
+
+	private:
+		void UpdateScore(float dt) {
+			// Every time the user gains 100 points, the score will blink on and off for 2 seconds to let them know.
+			if ((score > 0 && score % 100 == 0) || scoreBlinking) {
+				if (!scoreBlinking) scoreBlinking = true;
+				scoreTimer += dt;
+				if (scoreTimer > 2.0f) { // 2 second timer.
+					scoreBlinking = false;
+					scoreTimer = 0.0f;
+				}
+			}
+		}
+
+		void UpdateGround(float dt) {
+			int groundWidth = Info(SPRITE_GROUND).width;
+			if (started) {
+				groundOffset += dt * groundSpeed;
+				if (groundOffset >= groundWidth) groundOffset -= groundWidth;
+			}
+			groundSpeed = std::min(groundSpeed + dt, MAX_GROUND_SPEED);
+		}
+
+		void UpdateClouds(float dt) {
+			int cloudWidth = Info(SPRITE_CLOUD).width;
+			for (int i = 0; i < clouds.size(); i++) {
+				clouds[i].x -= dt * CLOUD_SPEED;
+			}
+
+			// Remove clouds that are off the screen. Clouds all move at the same speed, so these are at the front.
+			while (!clouds.empty() && clouds[0].x < -cloudWidth) clouds.pop_front();
+
+			// Randomly add clouds. Limit to 5 clouds.
+			if (started && rng.Range(CLOUD_CHANCE) == 0 && clouds.size() < 5) {
+				float y = float(rng.Range(world.cloudMaxY - world.cloudMinY) + world.cloudMinY);
+
+				// Make sure that clouds are drawn 1.5x cloud length apart to avoid overlap.
+				if (clouds.empty() || clouds.back().x < world.screenWidth - 3 * cloudWidth / 2) {
+					clouds.push_back({float(world.screenWidth), y, float(world.screenWidth)});
+				}
+			}
+		}
+	};
+}
@@ -7,28 +7,22 @@
 #define OLC_PGEX_SOUND
 #include "olcPGEX_Sound.h"
 
+#include "capture.h"
+#include "dino.h"
+#include "replay.h"
+#include "vecenv.h"
+
+#include <random>
+
 // Audio.
 #define GAMEOVER_AUDIO 0
 #define JUMP_AUDIO 1
 #define SCORE_AUDIO 2
 
-// Sprites.
-#define NUMBER 0
-#define CHAR_H 10
-#define CHAR_I 11
-#define ARROW 12
-#define CACTUS 12
-#define CLOUD 22
-#define DINO 23
-#define GAMEOVER 32
-#define GROUND 33
-#define PTERANODON 33
-#define SPRITES 36
-
+#define SCREEN_WIDTH 1100
+#define SCREEN_HEIGHT 320
 #define SCORE_DIGITS 5
-#define PLAYER_POSITION 60.0f
-#define JUMP_MULTIPLIER 15
-#define GROUND_SPEED 500.0f
+#define MAX_FRAME_TIME 0.25f // Longest frame the simulation catches up on, in seconds.
 
 class DinoGame : public olc::PixelGameEngine {
 public:
@@ -36,51 +30,95 @@ public:
 		sAppName = "Dino Game";
 	}
 
-private:
-	int screenWidth = 0;
-	int screenHeight = 0;
+	// Seed the game's random number generator. The same seed and input reproduce the same game.
+	void SetSeed(uint64_t seed) {
+		this->seed = seed;
+		sim.Seed(seed);
+	}
 
-	float time = 0.0f;
-	float groundSpeed = GROUND_SPEED;
-	float maxGroundSpeed = 1500.0f;
-	float cloudSpeed = 150.0f;
-	float fps = 30.0f;
-	float period = 1 / fps;
-	float elapsed = 0.0f;
-	int dinoIndex = 1; // Dino Sprite to draw.
+	// Record every key press delivered to the simulation to "path".
+	void Record(const std::string& path) {
+		recorder.Open(path, seed);
+	}
 
-	float jumpDuration = 0.75f; // Jump duration in seconds.
+	// Play back a recorded game instead of reading the keyboard. Headless builds simulate the whole
+	// replay in the first frame, unless it is being captured, and check it ends with the recorded score.
+	void Replay(const std::string& path) {
+		replay.Load(path);
+		replaying = true;
+		SetSeed(replay.seed);
+	}
 
-	bool started = false;
-	bool isJumping = false;
-	bool isDucking = false;
-	bool gameOver = false;
+	// Whether a replay was played to the end and reproduced the recorded game.
+	bool ReplayMatched() const {
+		return replayMatched;
+	}
 
-	float jumpTimer = 0.0f; // Timer for Dino Jump.
-	float pteranodonTimer = 0.0f; // Timer for wing flapping.
+	// Write every frame drawn to "path" from a background thread. See "capture.h" for the formats.
+	void Capture(const std::string& path) {
+#if defined(OLC_PGE_HEADLESS)
+		// Nothing paces a headless game, so waiting for the writer costs no frames.
+		capture.Open(path, true);
+#else
+		capture.Open(path, false);
+#endif
+		capturePath = path;
+		SetFrameReader([this](olc::Sprite* frame) { capture.Push(frame); });
+	}
 
-	bool scoreBlinking = false;
-	float scoreTimer = 0.0f;
+	// Draw every sprite from its own texture instead of from the sprite sheet.
+	void DisableAtlas() {
+		useAtlas = false;
+	}
 
-	int maxScore = 0;
-	int score = 0;
+	// Stop the game after "frames" frames. A negative value runs until the window is closed.
+	void SetFrameLimit(long long frames) {
+		frameLimit = frames;
+	}
 
-	struct enemy {
-		int width;
-		int height;
-		int index;
-		int type;
-		olc::vf2d pos;
-	};
+private:
+	int screenWidth = 0;
+	int screenHeight = 0;
 
-	olc::vf2d position; // Player position.
+	dino::Simulation sim;
+	dino::Input input; // Key presses not yet delivered to a simulation step.
+	float accumulator = 0.0f; // Time not yet simulated.
+
+	// Every sprite is a rectangle of the sprite sheet, so with the atlas a whole frame draws from a
+	// single texture. Otherwise each sprite is its own Decal, indexed by dino::Sprite.
+	bool useAtlas = true;
+	olc::Decal* atlas = nullptr;
 	std::vector<olc::Decal*> sprites;
-	std::vector<olc::vf2d> clouds;
-	std::vector<enemy> enemies;
+	olc::vf2d gameOverPos;
+	olc::vf2d arrowPos;
+
+	// The score, high score and "HI" label are only laid out again when what they show changes.
+	// With the atlas the whole HUD is then one triangle list over the sprite sheet.
+	struct HudGlyph {
+		olc::vf2d pos;
+		int sprite;
+	};
+	std::vector<HudGlyph> hudGlyphs;
+	std::vector<olc::vf2d> hudPos;
+	std::vector<olc::vf2d> hudUV;
+	int hudScore = -2; // Score shown by the cached HUD, -1 while it blinks off.
+	int hudMaxScore = -1;
 
 	// Audio.
 	std::vector<int> sounds;
 
+	long long frameLimit = -1;
+	long long frameCount = 0;
+
+	uint64_t seed = 0;
+	dino::Recorder recorder;
+	dino::Replay replay;
+	bool replaying = false;
+	bool replayMatched = false;
+
+	dino::FrameWriter capture;
+	std::string capturePath;
+
 public:
 	bool OnUserCreate() override {
 		screenWidth = ScreenWidth();
@@ -105,396 +143,421 @@ public:
 			sounds.push_back(id);
 		}
 
-		files.clear();
-		for (const auto& file : std::filesystem::directory_iterator(dir / spriteDir)) {
+		sim.Init(screenWidth, screenHeight);
+		if (useAtlas) {
+			LoadAtlas(dir / spriteDir);
+		} else {
+			LoadSprites(dir / spriteDir);
+		}
+
+		// Place the "Game Over" sprite and the restart arrow in the middle of the screen.
+		const dino::SpriteInfo& gameOver = dino::Info(dino::SPRITE_GAMEOVER);
+		const dino::SpriteInfo& arrow = dino::Info(dino::SPRITE_ARROW);
+		gameOverPos = {
+			float(screenWidth / 2 - gameOver.width / 2),
+			float(screenHeight / 2 - gameOver.height / 2 - screenHeight / 6)
+		};
+		arrowPos = {
+			float(screenWidth / 2 - arrow.width / 2),
+			float(screenHeight / 2 - arrow.height / 2 + screenHeight / 10)
+		};
+
+		return true;
+	}
+
+	// Load the sprite sheet as the only texture, and take the collision masks from its rectangles.
+	void LoadAtlas(const std::filesystem::path& spriteDir) {
+		std::string file = (spriteDir / dino::Info(dino::SPRITE_SHEET).name).string();
+		olc::Sprite* sheet = new olc::Sprite(file);
+		if (sheet->width != SHEET_WIDTH || sheet->height != SHEET_HEIGHT) {
+			delete sheet;
+			throw std::runtime_error("Failed to load sprite sheet: " + file);
+		}
+		atlas = new olc::Decal(sheet);
+
+		const uint8_t* pixels = (const uint8_t*)sheet->GetData();
+		for (int i = 0; i < dino::SPRITE_COUNT; i++) {
+			const dino::SpriteInfo& info = dino::Info(i);
+			sim.world.SetMask(i, pixels + (size_t(info.sheetY) * SHEET_WIDTH + info.sheetX) * 4, SHEET_WIDTH);
+		}
+	}
+
+	// Load every png file from the "sprites" directory as its own Decal.
+	void LoadSprites(const std::filesystem::path& spriteDir) {
+		std::vector<std::string> files;
+		for (const auto& file : std::filesystem::directory_iterator(spriteDir)) {
 			files.push_back(file.path().string());
 		}
-		
+
 		std::sort(files.begin(), files.end());
-		// Load Sprite png files from the "sprites" directory into the sprites vector.
-		for (const auto& file : files) {
-			olc::Sprite* sprite = new olc::Sprite(file);
-			if (sprite == nullptr) throw std::runtime_error("Failed to load sprite: " + file);
+		if (files.size() != dino::SPRITE_COUNT) throw std::runtime_error("Unexpected number of sprites in " + spriteDir.string());
+		// Load Sprite png files from the "sprites" directory into the sprites vector, and check
+		// each one is the sprite the sprite table expects.
+		for (int i = 0; i < dino::SPRITE_COUNT; i++) {
+			const dino::SpriteInfo& info = dino::Info(i);
+			olc::Sprite* sprite = new olc::Sprite(files[i]);
+			if (sprite == nullptr) throw std::runtime_error("Failed to load sprite: " + files[i]);
+			if (std::filesystem::path(files[i]).filename() != info.name) {
+				throw std::runtime_error("Expected sprite " + std::string(info.name) + ", found " + files[i]);
+			}
+			if (sprite->width != info.width || sprite->height != info.height) {
+				throw std::runtime_error("Sprite " + files[i] + " does not have the expected dimensions");
+			}
 			sprites.push_back(new olc::Decal(sprite));
 		}
 
 		// Delete unused sprites. These are present for completeness but are not used in the game.
-		delete sprites[DINO + 0]->sprite;
-		delete sprites[DINO + 0];
-		delete sprites[SPRITES]->sprite;
-		delete sprites[SPRITES];
-
-		srand(std::time(0));
-
-		return true;
+		delete sprites[dino::SPRITE_DINO_0]->sprite;
+		delete sprites[dino::SPRITE_DINO_0];
+		sprites[dino::SPRITE_DINO_0] = nullptr;
+		delete sprites[dino::SPRITE_SHEET]->sprite;
+		delete sprites[dino::SPRITE_SHEET];
+		sprites[dino::SPRITE_SHEET] = nullptr;
+
+		for (int i = 0; i < dino::SPRITE_COUNT; i++) {
+			if (sprites[i] != nullptr) sim.world.SetMask(i, (const uint8_t*)sprites[i]->sprite->GetData(), sprites[i]->sprite->width);
+		}
 	}
 
 	bool OnUserUpdate(float fElapsedTime) override {
-		Clear(olc::Pixel(230, 230, 230));
-
-		float elapsedTime = gameOver ? 0.0f : fElapsedTime;
-		DrawScore(elapsedTime);
-		DrawGround(elapsedTime);
-		DrawClouds(elapsedTime);
-		DrawEnemies(elapsedTime);
-
-		elapsed += fElapsedTime;
-		if (elapsed > period * 3.0f) { // Update every 3 frames.
-			elapsed = 0.0f;
-			// Find correct dinosaur sprite to draw based on game variables.
-			if (gameOver) {
-				dinoIndex = 6;
-			} else if (isJumping) {
-				dinoIndex = 1;
-			} else if (isDucking) {
-				dinoIndex = dinoIndex == 7 ? 8 : 7;
-			} else if (started) { // Dinosaur running animation.
-				dinoIndex = dinoIndex == 3 ? 4 : 3;
-			} else { // While the dinosaur is standing, it will randomly blink.
-				dinoIndex = rand() % 15 ? 1 : 2;
+		if (frameLimit >= 0 && frameCount >= frameLimit) return false;
+
+		if (replaying) {
+#if defined(OLC_PGE_HEADLESS)
+			// Unless the frames are being captured, nobody sees them, so there is no reason to pace the
+			// replay. A capture steps through it one frame at a time like a live game.
+			while (!capture.IsOpen() && sim.steps < replay.steps) {
+				dino::Input replayed = replay.InputAt(sim.steps);
+				recorder.Record(sim.steps, replayed);
+				sim.Step(replayed);
 			}
-
-			// Update score.
-			if (started && !gameOver) {
-				score++;
-				if (score > 0 && score % 100 == 0) {
-					olc::SOUND::PlaySample(sounds[SCORE_AUDIO]);
-				}
+#endif
+			if (sim.steps >= replay.steps) {
+				CheckReplay();
+				return false;
 			}
+		} else {
+#if defined(OLC_PGE_HEADLESS)
+			Autopilot();
+#endif
+			// Key presses are held until the next simulation step, which may not happen this frame.
+			if (GetKey(olc::Key::SPACE).bPressed) input.jump = true;
+			if (GetKey(olc::Key::DOWN).bPressed) input.duck = true;
+			if (GetKey(olc::Key::DOWN).bReleased) input.stand = true;
 		}
 
-		olc::Decal* dino = sprites[DINO + dinoIndex];
-		int dinoWidth = dino->sprite->width;
-		int dinoHeight = dino->sprite->height;
-		// Use a parabola to model the dinosaur jump. y = -a * (x^2 - b*x).
-		int maxJumpHeight = dinoHeight * JUMP_MULTIPLIER;
-		float jumpParabola = -maxJumpHeight * (jumpTimer * jumpTimer - jumpDuration * jumpTimer);
-		position.x = PLAYER_POSITION;
-		position.y = std::max(screenHeight - dinoHeight - 8 - jumpParabola, 0.0f);
-		DrawDecal(position, dino);
-
-		if (GetKey(olc::Key::SPACE).bPressed) {
-			// If space is pressed, start the game.
-			if (!started) {
-				gameOver = false;
-				started = true;
-				enemies.clear();
-			}
-			// If the game is already started, then cause the dinosaur to jump.
-			if (started) {
-				isJumping = true;
-				if (jumpTimer == 0.0f) {
-					olc::SOUND::PlaySample(sounds[JUMP_AUDIO]);
-				}
-			};
-		}
-
-		// Wait until the "jumpDuration" is over before the dino can jump again.
-		if (isJumping && !gameOver) {
-			jumpTimer += fElapsedTime;
-			if (jumpTimer > jumpDuration) {
-				isJumping = false;
-				jumpTimer = 0.0f;
-			}
+		// Run as many fixed steps as fit in the time that has passed. After a long stall, drop the
+		// time rather than trying to catch up all at once.
+		accumulator += std::min(fElapsedTime, MAX_FRAME_TIME);
+		while (accumulator >= STEP_TIME && !(replaying && sim.steps >= replay.steps)) {
+			if (replaying) input = replay.InputAt(sim.steps);
+			recorder.Record(sim.steps, input);
+			PlaySounds(sim.Step(input));
+			input = dino::Input();
+			accumulator -= STEP_TIME;
 		}
 
-		// If down arrow is pressed, duck the dinosaur.
-		if (GetKey(olc::Key::DOWN).bPressed && started) isDucking = true;
-		if (GetKey(olc::Key::DOWN).bReleased) isDucking = false;
-
-		if (gameOver) {
-			// Draw "Game Over" sprite in the middle of the screen.
-			olc::Decal* gameOverSprite = sprites[GAMEOVER];
-			olc::vf2d gameOverPos = {
-				float(screenWidth / 2 - gameOverSprite->sprite->width / 2),
-				float(screenHeight / 2 - gameOverSprite->sprite->height / 2 - screenHeight / 6)
-			};
-			DrawDecal(gameOverPos, gameOverSprite);
-			olc::Decal* arrowSprite = sprites[ARROW];
-			olc::vf2d arrowPos = {
-				float(screenWidth / 2 - arrowSprite->sprite->width / 2),
-				float(screenHeight / 2 - arrowSprite->sprite->height / 2 + screenHeight / 10)
-			};
-			DrawDecal(arrowPos, arrowSprite);
-		} else {
-			// Collision Detection.
-			for (auto& enemy : enemies) {
-				float ex0 = enemy.pos.x;
-				float ey0 = enemy.pos.y;
-				float ex1 = enemy.pos.x + enemy.width;
-				float ey1 = enemy.pos.y + enemy.height;
-
-				float px0 = position.x;
-				float py0 = position.y;
-				float px1 = position.x + dinoWidth;
-				float py1 = position.y + dinoHeight;
-
-				if (px0 > ex1) break;
-
-				// Rectangular Bounding Box Method.
-				bool noOverlap = ex0 > px1 || px0 > ex1 || ey0 > py1 || py0 > ey1;
-				if (!noOverlap) {
-					gameOver = true;
-					started = false;
-					maxScore = std::max(maxScore, score);
-					score = 0;
-					scoreTimer = 0;
-					scoreBlinking = false;
-					groundSpeed = GROUND_SPEED;
-
-					olc::SOUND::PlaySample(sounds[GAMEOVER_AUDIO]);
-					break;
-				}
-			}
+		// Fraction of a step that has passed since the last one, to draw between the two.
+		float alpha = accumulator / STEP_TIME;
+
+		Clear(olc::Pixel(230, 230, 230));
+		DrawScore();
+		DrawGround(alpha);
+		DrawClouds(alpha);
+		DrawEnemies(alpha);
+
+		float jumpHeight = sim.prevJumpHeight + (sim.jumpHeight - sim.prevJumpHeight) * alpha;
+		DrawSprite({PLAYER_POSITION, sim.DinoY(jumpHeight)}, dino::SPRITE_DINO_0 + sim.dinoIndex);
+
+		if (sim.gameOver) {
+			DrawSprite(gameOverPos, dino::SPRITE_GAMEOVER);
+			DrawSprite(arrowPos, dino::SPRITE_ARROW);
 		}
 
-		return true;
+		// The engine still presents the frame that stops the game, so the last frame stops it once drawn.
+		return frameLimit < 0 || ++frameCount < frameLimit;
 	}
 
 	bool OnUserDestroy() {
 		olc::SOUND::DestroyAudio();
+		recorder.Close(sim.steps, sim.score, sim.maxScore);
+		CloseCapture();
 
 		for (int i = 0; i < sprites.size(); i++) {
+			if (sprites[i] == nullptr) continue;
 			delete sprites[i]->sprite;
 			delete sprites[i];
 		}
+		if (atlas != nullptr) {
+			delete atlas->sprite;
+			delete atlas;
+		}
 
 		return true;
 	}
 
-	void DrawScore(float fElapsedTime) {
-		// Every time the user gains 100 points, the score will blink on and off for 2 seconds to let them know.
-		if ((score > 0 && score % 100 == 0) || scoreBlinking) {
-			if (!scoreBlinking) scoreBlinking = true;
-			scoreTimer += fElapsedTime;
-			if (scoreTimer > 2.0f) { // 2 second timer.
-				scoreBlinking = false;
-				scoreTimer = 0.0f;
-			}
+	void CheckReplay() {
+		replayMatched = sim.score == replay.score && sim.maxScore == replay.maxScore;
+		if (replayMatched) {
+			std::cout << "Replay matched after " << sim.steps << " steps: score " << sim.score
+				<< ", max score " << sim.maxScore << std::endl;
+		} else {
+			std::cerr << "Replay diverged after " << sim.steps << " steps: score " << sim.score
+				<< " (recorded " << replay.score << "), max score " << sim.maxScore
+				<< " (recorded " << replay.maxScore << ")" << std::endl;
 		}
+	}
 
-		if (started || gameOver) {
-			// All number/letter sprites have the same width.
-			int digitWidth = sprites[NUMBER + 0]->sprite->width;
-			int digitHeight = sprites[NUMBER + 0]->sprite->height;
+	void CloseCapture() {
+		if (!capture.IsOpen()) return;
+		if (!capture.Close()) {
+			std::cerr << "Failed to write capture: " << capturePath << std::endl;
+			return;
+		}
+		std::cout << "Captured " << capture.Written() << " frames to " << capturePath;
+		if (capture.Dropped() > 0) std::cout << ", dropped " << capture.Dropped() << " while the writer was behind";
+		std::cout << std::endl;
+		if (capture.Written() == 0) std::cerr << "This renderer cannot read frames back, see the README" << std::endl;
+	}
 
-			int offset = 2 * digitWidth;
-			if (scoreBlinking) {
-				if ((int(scoreTimer * 3)) % 2 == 0) {
-					DrawNumber(score / 100 * 100, offset, SCORE_DIGITS);
-				}
-			} else {
-				DrawNumber(score, offset, SCORE_DIGITS);
+	void PlaySounds(uint32_t events) {
+		if (events & dino::EVENT_JUMP) olc::SOUND::PlaySample(sounds[JUMP_AUDIO]);
+		if (events & dino::EVENT_SCORE) olc::SOUND::PlaySample(sounds[SCORE_AUDIO]);
+		if (events & dino::EVENT_GAMEOVER) olc::SOUND::PlaySample(sounds[GAMEOVER_AUDIO]);
+	}
+
+#if defined(OLC_PGE_HEADLESS)
+	// With no keyboard attached, hold SPACE to start the game (and restart it after a game over),
+	// and to jump over any enemy about to reach the dinosaur. Key states set here are seen next frame.
+	void Autopilot() {
+		bool jump = !sim.started;
+		const dino::EnemyList& enemies = sim.enemies;
+		for (int i = 0; i < enemies.size(); i++) {
+			float gap = enemies.x[enemies.Slot(i)] - (PLAYER_POSITION + dino::Info(dino::SPRITE_DINO_1).width);
+			if (gap > 0.0f && gap < sim.groundSpeed * 0.15f) {
+				jump = true;
+				break;
 			}
+		}
+		olc_UpdateKeyState(olc::Key::SPACE, jump && !GetKey(olc::Key::SPACE).bHeld);
+	}
+#endif
 
-			// If the user has reached a new max score, their max score will be displayed to the left of their
-			// current score once they lose.
-			if (maxScore > 0) {
-				offset += (SCORE_DIGITS + 1) * digitWidth;
-				DrawNumber(maxScore, offset, SCORE_DIGITS);
-				offset += (SCORE_DIGITS + 1) * digitWidth;
-				DrawDecal({float(screenWidth - offset), float(digitHeight / 2)}, sprites[CHAR_I]);
-				offset += digitWidth;
-				DrawDecal({float(screenWidth - offset), float(digitHeight / 2)}, sprites[CHAR_H]);
+	// Draw "sprite" with its top left corner at "pos".
+	void DrawSprite(const olc::vf2d& pos, int sprite) {
+		if (atlas != nullptr) {
+			const dino::SpriteInfo& info = dino::Info(sprite);
+			DrawPartialDecal(pos, atlas, {float(info.sheetX), float(info.sheetY)}, {float(info.width), float(info.height)});
+		} else {
+			DrawDecal(pos, sprites[sprite]);
+		}
+	}
+
+	void DrawScore() {
+		if (!sim.started && !sim.gameOver) return;
+
+		// While blinking, the score shows its hundreds every other third of a second.
+		int shown = sim.score;
+		if (sim.scoreBlinking) {
+			shown = (int(sim.scoreTimer * 3)) % 2 == 0 ? sim.score / 100 * 100 : -1;
+		}
+		if (shown != hudScore || sim.maxScore != hudMaxScore) {
+			LayoutScore(shown, sim.maxScore);
+		}
+
+		if (atlas != nullptr) {
+			if (hudPos.empty()) return;
+			SetDecalStructure(olc::DecalStructure::LIST);
+			DrawPolygonDecal(atlas, hudPos, hudUV);
+			SetDecalStructure(olc::DecalStructure::FAN);
+		} else {
+			for (const HudGlyph& glyph : hudGlyphs) {
+				DrawSprite(glyph.pos, glyph.sprite);
 			}
 		}
 	}
 
-	void DrawNumber(int num, int offset, int pad) {
-		int digitWidth = sprites[NUMBER + 0]->sprite->width;
-		int digitHeight = sprites[NUMBER + 0]->sprite->height;
+	void LayoutScore(int score, int maxScore) {
+		// All number/letter sprites have the same dimensions.
+		constexpr int digitWidth = dino::Info(dino::SPRITE_0).width;
+		constexpr int digitHeight = dino::Info(dino::SPRITE_0).height;
+
+		hudScore = score;
+		hudMaxScore = maxScore;
+		hudGlyphs.clear();
+
+		int offset = 2 * digitWidth;
+		if (score >= 0) {
+			LayoutNumber(score, offset, SCORE_DIGITS);
+		}
+
+		// If the user has reached a new max score, their max score will be displayed to the left of their
+		// current score once they lose.
+		if (maxScore > 0) {
+			offset += (SCORE_DIGITS + 1) * digitWidth;
+			LayoutNumber(maxScore, offset, SCORE_DIGITS);
+			offset += (SCORE_DIGITS + 1) * digitWidth;
+			hudGlyphs.push_back({{float(screenWidth - offset), float(digitHeight / 2)}, dino::SPRITE_I});
+			offset += digitWidth;
+			hudGlyphs.push_back({{float(screenWidth - offset), float(digitHeight / 2)}, dino::SPRITE_H});
+		}
+
+		// Two triangles per glyph, in the same corners DrawPartialDecal would use.
+		hudPos.clear();
+		hudUV.clear();
+		for (const HudGlyph& glyph : hudGlyphs) {
+			const dino::SpriteInfo& info = dino::Info(glyph.sprite);
+			olc::vf2d tl = glyph.pos;
+			olc::vf2d br = tl + olc::vf2d(float(info.width), float(info.height));
+			hudPos.insert(hudPos.end(), {tl, {tl.x, br.y}, br, tl, br, {br.x, tl.y}});
+			hudUV.insert(hudUV.end(), {{info.u0, info.v0}, {info.u0, info.v1}, {info.u1, info.v1},
+				{info.u0, info.v0}, {info.u1, info.v1}, {info.u1, info.v0}});
+		}
+	}
+
+	void LayoutNumber(int num, int offset, int pad) {
+		constexpr int digitWidth = dino::Info(dino::SPRITE_0).width;
+		constexpr int digitHeight = dino::Info(dino::SPRITE_0).height;
 		int addedOffset = 0;
 		int count = 0;
 		while (num > 0 && count < pad) {
-			olc::Decal* digitDecal = sprites[NUMBER + num % 10];
-			DrawDecal({float(screenWidth - offset - addedOffset), float(digitHeight / 2)}, digitDecal);
+			hudGlyphs.push_back({{float(screenWidth - offset - addedOffset), float(digitHeight / 2)}, dino::SPRITE_0 + num % 10});
 			addedOffset += digitWidth;
 			num /= 10;
 			count++;
 		}
 		// Zero pad the score so it reaches "pad" number of digits.
 		for (int i = 0; i < pad - count; i++) {
-			DrawDecal({float(screenWidth - offset - addedOffset), float(digitHeight / 2)}, sprites[NUMBER + 0]);
+			hudGlyphs.push_back({{float(screenWidth - offset - addedOffset), float(digitHeight / 2)}, dino::SPRITE_0});
 			addedOffset += digitWidth;
 		}
 	}
 
-	void DrawGround(float fElapsedTime) {
-		olc::Decal* ground = sprites[GROUND];
-		int groundWidth = ground->sprite->width;
-		int groundHeight = ground->sprite->height;
+	void DrawGround(float alpha) {
+		constexpr int groundWidth = dino::Info(dino::SPRITE_GROUND).width;
+		constexpr int groundHeight = dino::Info(dino::SPRITE_GROUND).height;
 
-		// Draw Ground moving right to left.
-		if (started || gameOver) {
-			int x = - time * groundSpeed;
-			if (x <= -groundWidth) {
-				time = 0.0f;
-			}
-			if (x + groundWidth <= screenWidth) {
-				DrawDecal({float(x + groundWidth), float(screenHeight - groundHeight)}, ground);
-			}
-			DrawDecal({float(x), float(screenHeight - groundHeight)}, ground);
-		} else {
-			DrawDecal({0.0f, float(screenHeight - groundHeight)}, ground);
+		// Draw Ground moving right to left. The offset wraps around, so unwrap it before interpolating.
+		float prevOffset = sim.prevGroundOffset;
+		if (prevOffset > sim.groundOffset) prevOffset -= groundWidth;
+		float x = -std::floor(prevOffset + (sim.groundOffset - prevOffset) * alpha);
+		if (x + groundWidth <= screenWidth) {
+			DrawSprite({x + groundWidth, float(screenHeight - groundHeight)}, dino::SPRITE_GROUND);
 		}
-
-		time += fElapsedTime;
-		groundSpeed = std::min(groundSpeed + fElapsedTime, maxGroundSpeed);
+		DrawSprite({x, float(screenHeight - groundHeight)}, dino::SPRITE_GROUND);
 	}
 
-	void DrawEnemies(float fElapsedTime) {
-		pteranodonTimer += fElapsedTime;
-		if (pteranodonTimer > period * 5.0f) { // Update every 5 frames.
-			pteranodonTimer = 0.0f;
-			// Flap the wings of the pteranodons.
-			for (auto& enemy : enemies) {
-				if (enemy.type == PTERANODON) {
-					enemy.index = enemy.index % 2 + 1;
-				}
-			}
-		}
-
-		// Draw Enemies.
-		for (auto& enemy : enemies) {
-			olc::Decal* sprite = sprites[enemy.type + enemy.index];
-			if (sprite == nullptr) continue;
-			enemy.pos.x -= fElapsedTime * groundSpeed;
-			DrawDecal(enemy.pos, sprite);
+	void DrawEnemies(float alpha) {
+		const dino::EnemyList& enemies = sim.enemies;
+		for (int i = 0; i < enemies.size(); i++) {
+			int slot = enemies.Slot(i);
+			float x = enemies.prevX[slot] + (enemies.x[slot] - enemies.prevX[slot]) * alpha;
+			DrawSprite({x, enemies.y[slot]}, enemies.sprite[slot]);
 		}
+	}
 
-		// Remove enemies that are off the screen.
-		if (enemies.size() > 0) {
-			auto i = std::remove_if(
-				enemies.begin(),
-				enemies.end(),
-				[](const enemy& enemy) { return enemy.pos.x < -enemy.width; }
-			);
-			if (i != enemies.end()) enemies.erase(i);
+	void DrawClouds(float alpha) {
+		for (int i = 0; i < sim.clouds.size(); i++) {
+			const dino::Cloud& pos = sim.clouds[i];
+			float x = pos.prevX + (pos.x - pos.prevX) * alpha;
+			DrawSprite({x, pos.y}, dino::SPRITE_CLOUD);
 		}
+	}
+};
 
-		// Add enemies. Wait until the user has a score of 25 to add enemies.
-		if (score >= 25 && rand() % 200 == 0) {
-			if (rand() % 300 > 50) {
-				AddCactus();
-			} else {
-				AddPteranodon();
-			}			
+// Step "envs" games in lockstep for "steps" steps with a simple scripted policy, and report the throughput.
+// Only the collision masks are loaded and nothing is drawn, so this runs without a window in any build.
+void RunVecEnv(int envs, long long steps, uint64_t seed) {
+	dino::World world(SCREEN_WIDTH, SCREEN_HEIGHT);
+	for (int i = 0; i < dino::SPRITE_COUNT; i++) {
+		if (!dino::Collidable(i)) continue;
+		olc::Sprite sprite((std::filesystem::current_path() / "sprites" / dino::Info(i).name).string());
+		if (sprite.width != dino::Info(i).width || sprite.height != dino::Info(i).height) {
+			throw std::runtime_error(std::string("Failed to load sprite: ") + dino::Info(i).name);
 		}
+		world.SetMask(i, (const uint8_t*)sprite.GetData(), sprite.width);
 	}
 
-	void AddPteranodon() {
-		int dinoHeight = sprites[DINO + 1]->sprite->height;
-		int dinoDuckHeight = sprites[DINO + 7]->sprite->height;
-		int lowPteranodonHeight = (screenHeight - dinoHeight - 8) - dinoDuckHeight;
-		int highPteranodonHeight = screenHeight - 2 * dinoHeight - 8 - 8;
-		// For the Pteranodon, choose between a low flyer and a high flyer.
-		int y = rand() % 2 ? lowPteranodonHeight : highPteranodonHeight;
-
-		int index = rand() % 2 + 1;
-		olc::Decal* sprite = sprites[PTERANODON + index];
-		int width = sprite->sprite->width;
-		int height = sprite->sprite->height;
-
-		if (enemies.empty()) {
-			enemies.push_back({width, height, index, PTERANODON, {float(screenWidth), float(y)}});
-		} else {
-			// If the "enemies" vector is not empty, then wait and see if the last element's position
-			// is far enough away such that the current enemy can be drawn without any overlap.
-			enemy last = enemies.back();
-			int jumpLength = jumpDuration * groundSpeed;
-			if (last.pos.x < screenWidth - last.width - jumpLength) {
-				enemies.push_back({width, height, index, PTERANODON, {float(screenWidth), float(y)}});
+	dino::VecEnv env(world, envs, seed);
+	std::vector<uint8_t> actions(envs);
+	long long episodes = 0;
+	long long totalScore = 0;
+
+	auto start = std::chrono::steady_clock::now();
+	for (long long step = 0; step < steps; step++) {
+		const float* obs = env.Observations();
+		for (int i = 0; i < envs; i++) {
+			// Jump when the next enemy is close.
+			float distance = obs[i * OBSERVATION_SIZE + 3];
+			actions[i] = distance > 0.0f && distance < 0.12f ? dino::ACTION_JUMP : dino::ACTION_NONE;
+		}
+		env.Step(actions.data());
+		for (int i = 0; i < envs; i++) {
+			if (env.Dones()[i]) {
+				episodes++;
+				totalScore += env.Scores()[i];
 			}
 		}
 	}
+	float seconds = std::chrono::duration<float>(std::chrono::steady_clock::now() - start).count();
 
-	void AddCactus() {
-		if (enemies.empty()) {
-			int index = rand() % 8 + 1; // Randomly choose any cactus other than "cactus_9".
-			olc::Decal* sprite = sprites[CACTUS + index];
-			enemies.push_back({
-				sprite->sprite->width, sprite->sprite->height, index, CACTUS,
-				{float(screenWidth), float(screenHeight - sprite->sprite->height - 4)}
-			});
+	std::cout << envs << " games x " << steps << " steps in " << seconds << "s: "
+		<< (envs * steps) / seconds << " game steps/s, " << episodes << " episodes, mean score "
+		<< (episodes > 0 ? float(totalScore) / episodes : 0.0f) << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+	DinoGame demo;
+	demo.SetSeed(std::random_device()() ^ uint64_t(std::time(0)));
+
+	std::string recordPath;
+	std::string replayPath;
+	std::string capturePath;
+	int vecEnvs = 0;
+	long long vecEnvSteps = 0;
+	uint64_t seed = std::random_device()();
+	for (int i = 1; i < argc; i++) {
+		std::string arg = argv[i];
+		if (arg == "--frames" && i + 1 < argc) {
+			demo.SetFrameLimit(std::stoll(argv[++i]));
+		} else if (arg == "--no-atlas") {
+			demo.DisableAtlas();
+		} else if (arg == "--render-thread") {
+			demo.SetRenderThread(true);
+		} else if (arg == "--threads" && i + 1 < argc) {
+			demo.SetRendererThreads(std::max(std::stoi(argv[++i]), 0));
+		} else if (arg == "--seed" && i + 1 < argc) {
+			seed = std::stoull(argv[++i]);
+			demo.SetSeed(seed);
+		} else if (arg == "--record" && i + 1 < argc) {
+			recordPath = argv[++i];
+		} else if (arg == "--replay" && i + 1 < argc) {
+			replayPath = argv[++i];
+		} else if (arg == "--capture" && i + 1 < argc) {
+			capturePath = argv[++i];
+		} else if (arg == "--vecenv" && i + 2 < argc && std::stoi(argv[i + 1]) > 0) {
+			vecEnvs = std::stoi(argv[++i]);
+			vecEnvSteps = std::stoll(argv[++i]);
 		} else {
-			// If the "enemies" vector is not empty, then wait and see if the last element's position
-			// is far enough away such that the current enemy can be drawn without any overlap.
-			enemy last = enemies.back();
-			int jumpLength = jumpDuration * groundSpeed;
-			if (last.pos.x < screenWidth - last.width - jumpLength) {
-				int index = rand() % 9 + 1;
-				// "cactus_9" is the largest cactus sprite.
-				// If we choose this cactus, then we only draw one sprite.
-				if (index == 9 && sprites[CACTUS + 9]->sprite->width <= jumpLength) {
-					olc::Decal* sprite = sprites[CACTUS + 9];
-					enemies.push_back({
-						sprite->sprite->width, sprite->sprite->height, index, CACTUS,
-						{float(screenWidth), float(screenHeight - sprite->sprite->height - 4)}
-					});
-				} else {
-					int offset = 0;
-					// Add 1-4 cactuses in a row.
-					for (int i = 0; (i < rand() % 4 + 1) && offset <= jumpLength; i++) {
-						int index = rand() % 8 + 1;
-						olc::Decal* sprite = sprites[CACTUS + index];
-						enemies.push_back({
-							sprite->sprite->width, sprite->sprite->height, index, CACTUS,
-							{float(screenWidth + offset), float(screenHeight - sprite->sprite->height - 4)}
-						});
-						offset += enemies.back().width;
-					}
-				}
-			}
+			std::cerr << "Usage: " << argv[0] << " [--frames N] [--no-atlas] [--render-thread] [--threads N] [--seed N] [--record FILE] [--replay FILE] [--capture FILE] [--vecenv GAMES STEPS]" << std::endl;
+			return 1;
 		}
 	}
 
-	void DrawClouds(float fElapsedTime) {
-		// Draw Clouds.
-		olc::Decal* cloud = sprites[CLOUD];
-		int cloudWidth = cloud->sprite->width;
-		int cloudHeight = cloud->sprite->height;
-		for (auto& pos : clouds) {
-			pos.x -= fElapsedTime * cloudSpeed;
-			DrawDecal(pos, cloud);
-		}
-
-		// Remove clouds that are off the screen.
-		if (clouds.size() > 0) {
-			auto i = std::remove_if(
-				clouds.begin(),
-				clouds.end(),
-				[cloudWidth](const olc::vf2d& pos) { return pos.x < -cloudWidth; }
-			);
-			if (i != clouds.end()) clouds.erase(i);
-		}
-
-		// Randomly add clouds. Limit to 5 clouds.
-		if (started && rand() % 1000 == 0 && clouds.size() < 5) {
-			// All dino sprites have the same dimensions.
-			int dinoHeight = sprites[DINO + 1]->sprite->height;
-			int begin = cloudHeight + 10;
-			int end = screenHeight - cloudHeight - dinoHeight - 8;
-			int y = rand() % (begin - end) + begin;
-
-			// Make sure that clouds are drawn 1.5x cloud length apart to avoid overlap.
-			if (clouds.empty()) {
-				clouds.push_back({float(screenWidth), float(y)});
-			} else {
-				// If the "clouds" vector is not empty, then wait and see if the last element's position
-				// is far enough away such that the current enemy can be drawn without any overlap.
-				olc::vf2d last = clouds.back();
-				if (last.x < screenWidth - 3 * cloudWidth / 2) {
-					clouds.push_back({float(screenWidth), float(y)});
-				}
-			}
-		}
+	if (vecEnvs > 0) {
+		RunVecEnv(vecEnvs, vecEnvSteps, seed);
+		return 0;
 	}
-};
 
-int main() {
-	DinoGame demo;
-	if (demo.Construct(1100, 320, 1, 1))
+	// A replay brings its own seed, which a new recording then has to use.
+	if (!replayPath.empty()) demo.Replay(replayPath);
+	if (!recordPath.empty()) demo.Record(recordPath);
+	if (!capturePath.empty()) demo.Capture(capturePath);
+
+	if (demo.Construct(SCREEN_WIDTH, SCREEN_HEIGHT, 1, 1))
 		demo.Start();
 
+	if (!replayPath.empty() && !demo.ReplayMatched()) return 1;
+
 	return 0;
-}
\ No newline at end of file
+}
@@ -79,8 +79,9 @@
 #undef min
 #undef max
 
-// Choose a default sound backend
-#if !defined(USE_ALSA) && !defined(USE_OPENAL) && !defined(USE_WINDOWS)
+// Choose a default sound backend. Headless builds have no sound device to talk
+// to, so they fall through to the silent backend unless one is forced
+#if !defined(USE_ALSA) && !defined(USE_OPENAL) && !defined(USE_WINDOWS) && !defined(OLC_PGE_HEADLESS)
 #ifdef __linux__
 #define USE_ALSA
 #endif
@@ -346,6 +347,10 @@ namespace olc
 	// Add sample 'id' to the mixers sounds to play list
 	void SOUND::PlaySample(int id, bool bLoop)
 	{
+		// Nothing would ever mix (and so retire) the sample without an audio thread
+		if (!m_bAudioThreadActive)
+			return;
+
 		olc::SOUND::sCurrentlyPlayingSample a;
 		a.nAudioSampleID = id;
 		a.nSamplePosition = 0;
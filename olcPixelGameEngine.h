@@ -354,12 +354,19 @@ int main()
 #include <list>
 #include <thread>
 #include <atomic>
+#include <mutex>
+#include <condition_variable>
 #include <fstream>
 #include <map>
 #include <functional>
 #include <algorithm>
 #include <array>
 #include <cstring>
+#if defined(__AVX__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#endif
 #pragma endregion
 
 #define PGE_VER 217
@@ -424,7 +431,7 @@ int main()
 #endif
 
 // Start Situation
-#if defined(OLC_PLATFORM_GLUT) || defined(OLC_PLATFORM_EMSCRIPTEN)
+#if (defined(OLC_PLATFORM_GLUT) || defined(OLC_PLATFORM_EMSCRIPTEN)) && !defined(OLC_PGE_HEADLESS)
 	#define PGE_USE_CUSTOM_START
 #endif
 
@@ -439,6 +446,17 @@ int main()
 	#endif
 #endif
 
+// The software renderer keeps its frames in memory, as there is no window to present them to
+#if defined(OLC_GFX_SOFTWARE) && !defined(OLC_PGE_HEADLESS)
+	#error "OLC_GFX_SOFTWARE needs OLC_PGE_HEADLESS"
+#endif
+
+// Threads the software renderer draws each frame with, 0 for one per hardware thread.
+// PixelGameEngine::SetRendererThreads() overrides it at run time
+#if !defined(OLC_SOFTWARE_THREADS)
+	#define OLC_SOFTWARE_THREADS 0
+#endif
+
 // Image loader
 #if !defined(OLC_IMAGE_STB) && !defined(OLC_IMAGE_GDI) && !defined(OLC_IMAGE_LIBPNG)
 	#if !defined(OLC_IMAGE_CUSTOM_EX)
@@ -455,8 +473,8 @@ int main()
 // O------------------------------------------------------------------------------O
 // | PLATFORM-SPECIFIC DEPENDENCIES                                               |
 // O------------------------------------------------------------------------------O
-#if !defined(OLC_PGE_HEADLESS)
-#if defined(OLC_PLATFORM_WINAPI)	
+// GDI+ loads images without a window, so headless Windows builds keep the Windows headers for it
+#if defined(OLC_PLATFORM_WINAPI) && (!defined(OLC_PGE_HEADLESS) || defined(OLC_IMAGE_GDI))
 	#define _WINSOCKAPI_ // Thanks Cornchipss
 		#if !defined(VC_EXTRALEAN)
 		#define VC_EXTRALEAN
@@ -478,6 +496,8 @@ int main()
 	#undef _WINSOCKAPI_
 #endif
 
+#if !defined(OLC_PGE_HEADLESS)
+
 #if defined(OLC_PLATFORM_X11)
 	namespace X11
 	{
@@ -751,8 +771,18 @@ namespace olc
 		Pixel* GetData();
 		olc::Sprite* Duplicate();
 		olc::Sprite* Duplicate(const olc::vi2d& vPos, const olc::vi2d& vSize);
+		// Rows changed since MarkClean(), so a texture of this sprite only needs those rows
+		// uploaded. SetPixel() and Clear() keep track, writes through GetData() must call MarkDirty()
+		void MarkDirty();
+		void MarkDirty(int32_t y0, int32_t y1);
+		void MarkClean();
+		bool IsDirty() const;
 		std::vector<olc::Pixel> pColData;
 		Mode modeSample = Mode::NORMAL;
+		int32_t nDirtyTop = 0;    // First changed row
+		int32_t nDirtyBottom = 0; // One past the last changed row
+		bool bSolid = false;      // Every pixel is pSolid, as left by PixelGameEngine::Clear()
+		olc::Pixel pSolid;
 
 		static std::unique_ptr<olc::ImageLoader> loader;
 	};
@@ -818,16 +848,56 @@ namespace olc
 	// | Auxilliary components internal to engine                                     |
 	// O------------------------------------------------------------------------------O
 
+	// A decal submitted for drawing. Quads, which is almost every decal, keep their vertices inline.
+	// Polygons with more points keep them in the layer's vertex arena. Either way the vertex pointers
+	// are only valid while the instance is written, and again once its layer is drawn.
 	struct DecalInstance
 	{
+		static constexpr uint32_t nInlinePoints = 4;
+
 		olc::Decal* decal = nullptr;
+		olc::vf2d* pos = nullptr;
+		olc::vf2d* uv = nullptr;
+		float* w = nullptr;
+		olc::Pixel* tint = nullptr;
+		olc::DecalMode mode = olc::DecalMode::NORMAL;
+		olc::DecalStructure structure = olc::DecalStructure::FAN;
+		uint32_t points = 0;
+		uint32_t nArenaOffset = 0; // First vertex in the arena when points > nInlinePoints.
+
+		olc::vf2d vInlinePos[nInlinePoints];
+		olc::vf2d vInlineUV[nInlinePoints];
+		float fInlineW[nInlinePoints];
+		olc::Pixel pInlineTint[nInlinePoints];
+	};
+
+	// Vertices of the decal instances of one layer that do not fit inline. Cleared every frame
+	// but never shrunk, so it stops allocating once it has grown to the largest frame.
+	struct DecalVertexArena
+	{
 		std::vector<olc::vf2d> pos;
 		std::vector<olc::vf2d> uv;
 		std::vector<float> w;
 		std::vector<olc::Pixel> tint;
-		olc::DecalMode mode = olc::DecalMode::NORMAL;
-		olc::DecalStructure structure = olc::DecalStructure::FAN;
-		uint32_t points = 0;
+
+		// Point "di" at its vertices, which may have moved since it was added
+		void Bind(DecalInstance& di)
+		{
+			if (di.points <= DecalInstance::nInlinePoints)
+			{
+				di.pos = di.vInlinePos; di.uv = di.vInlineUV; di.w = di.fInlineW; di.tint = di.pInlineTint;
+			}
+			else
+			{
+				di.pos = &pos[di.nArenaOffset]; di.uv = &uv[di.nArenaOffset];
+				di.w = &w[di.nArenaOffset]; di.tint = &tint[di.nArenaOffset];
+			}
+		}
+
+		void clear()
+		{
+			pos.clear(); uv.clear(); w.clear(); tint.clear();
+		}
 	};
 
 	struct LayerDesc
@@ -839,8 +909,28 @@ namespace olc
 		olc::Renderable pDrawTarget;
 		uint32_t nResID = 0;
 		std::vector<DecalInstance> vecDecalInstance;
+		DecalVertexArena decalArena;
+		olc::Pixel tint = olc::WHITE;
+		std::function<void()> funcHook = nullptr;
+	};
+
+	// Everything the renderer needs to draw one layer for one frame. The frame loop hands the
+	// layer's decals over by swapping vectors, so neither side allocates once both have grown
+	struct LayerFrame
+	{
+		bool bShow = false;
+		bool bUpdate = false; // Upload rows [nUpdateTop, nUpdateBottom) of pSprite to the layer's texture before drawing
+		int32_t nUpdateTop = 0;
+		int32_t nUpdateBottom = 0;
+		uint32_t nTexture = 0;
+		olc::Sprite* pSprite = nullptr;
+		std::unique_ptr<olc::Sprite> pCopy; // Private copy of the layer's pixels when rendering on another thread
+		olc::vf2d vOffset = { 0, 0 };
+		olc::vf2d vScale = { 1, 1 };
 		olc::Pixel tint = olc::WHITE;
 		std::function<void()> funcHook = nullptr;
+		std::vector<DecalInstance> vecDecalInstance;
+		DecalVertexArena decalArena;
 	};
 
 	class Renderer
@@ -855,13 +945,26 @@ namespace olc
 		virtual void	   SetDecalMode(const olc::DecalMode& mode) = 0;
 		virtual void       DrawLayerQuad(const olc::vf2d& offset, const olc::vf2d& scale, const olc::Pixel tint) = 0;
 		virtual void       DrawDecal(const olc::DecalInstance& decal) = 0;
+		// Draw a layer's decals in order. Renderers that can merge decals into fewer draw calls override this
+		virtual void       DrawDecals(const olc::DecalInstance* decals, size_t count) { for (size_t i = 0; i < count; i++) DrawDecal(decals[i]); }
 		virtual uint32_t   CreateTexture(const uint32_t width, const uint32_t height, const bool filtered = false, const bool clamp = true) = 0;
 		virtual void       UpdateTexture(uint32_t id, olc::Sprite* spr) = 0;
+		// Upload rows [y0, y1) of "spr" to a texture that already has its size. Defaults to a full upload
+		virtual void       UpdateTextureRows(uint32_t id, olc::Sprite* spr, int32_t y0, int32_t y1) { UNUSED(y0); UNUSED(y1); UpdateTexture(id, spr); }
 		virtual void       ReadTexture(uint32_t id, olc::Sprite* spr) = 0;
+		// Read back the frame being drawn without waiting for the GPU, for screenshots and capture.
+		// BeginFrameRead() queues a copy of the viewport and returns false if the renderer cannot
+		// queue one, or its queue is full. EndFrameRead() moves the oldest queued frame into "spr",
+		// top row first, and returns false if none is queued or, unless "bWait", it has not arrived
+		virtual bool       BeginFrameRead() { return false; }
+		virtual bool       EndFrameRead(olc::Sprite* spr, bool bWait) { UNUSED(spr); UNUSED(bWait); return false; }
 		virtual uint32_t   DeleteTexture(const uint32_t id) = 0;
 		virtual void       ApplyTexture(uint32_t id) = 0;
 		virtual void       UpdateViewport(const olc::vi2d& pos, const olc::vi2d& size) = 0;
 		virtual void       ClearBuffer(olc::Pixel p, bool bDepth) = 0;
+		// Threads a renderer that draws on the CPU may use, 0 for one per hardware thread. Applied
+		// when the device is created, and ignored by renderers that draw on the GPU
+		virtual void       SetThreads(int32_t n) { UNUSED(n); }
 		static olc::PixelGameEngine* ptrPGE;
 	};
 
@@ -955,6 +1058,19 @@ namespace olc
 		const olc::vi2d& GetPixelSize() const;
 		// Gets actual pixel scale
 		const olc::vi2d& GetScreenPixelSize() const;
+		// Sets the fixed time per frame reported when running headless
+		void SetHeadlessElapsedTime(float fElapsedTime);
+		// Run OnUserUpdate on its own thread, so the next frame is simulated while the last one is
+		// submitted and presented. Call before Start(). Textures must then only be created, updated
+		// or destroyed in OnUserCreate and OnUserDestroy, which stay on the rendering thread
+		void SetRenderThread(bool bEnable);
+		// Threads a renderer drawing on the CPU (OLC_GFX_SOFTWARE) uses per frame, 0 for one per
+		// hardware thread. Call before Start(). Renderers drawing on the GPU ignore it
+		void SetRendererThreads(int32_t nThreads);
+		// Read back every frame drawn from now on and hand it to "func", top row first, on the
+		// rendering thread. Reads are queued so the renderer is only waited on once its queue is full.
+		// "func" may take the sprite's pixels by swapping them out. Pass nullptr to stop
+		void SetFrameReader(std::function<void(olc::Sprite*)> func);
 
 	public: // CONFIGURATION ROUTINES
 		// Layer targeting functions
@@ -1104,25 +1220,31 @@ namespace olc
 		olc::Sprite*     pDrawTarget = nullptr;
 		Pixel::Mode	nPixelMode = Pixel::NORMAL;
 		float		fBlendFactor = 1.0f;
+		uint32_t	nBlendFactor = 256; // fBlendFactor in 8.8 fixed point, for the integer blend
 		olc::vi2d	vScreenSize = { 256, 240 };
 		olc::vf2d	vInvScreenSize = { 1.0f / 256.0f, 1.0f / 240.0f };
 		olc::vi2d	vPixelSize = { 4, 4 };
 		olc::vi2d   vScreenPixelSize = { 4, 4 };
 		olc::vi2d	vMousePos = { 0, 0 };
 		int32_t		nMouseWheelDelta = 0;
+		olc::vi2d	vMouseWindowPos = { 0, 0 };
+		// Input caches, written by whichever thread handles system events and taken once a frame.
+		// With a render thread that is not the thread running OnUserUpdate
+		std::mutex	muxInput;
 		olc::vi2d	vMousePosCache = { 0, 0 };
-		olc::vi2d   vMouseWindowPos = { 0, 0 };
+		olc::vi2d	vMouseWindowPosCache = { 0, 0 };
 		int32_t		nMouseWheelDeltaCache = 0;
 		olc::vi2d	vWindowSize = { 0, 0 };
 		olc::vi2d	vViewPos = { 0, 0 };
 		olc::vi2d	vViewSize = { 0,0 };
 		bool		bFullScreen = false;
 		olc::vf2d	vPixel = { 1.0f, 1.0f };
-		bool		bHasInputFocus = false;
-		bool		bHasMouseFocus = false;
+		std::atomic<bool> bHasInputFocus{ false };
+		std::atomic<bool> bHasMouseFocus{ false };
 		bool		bEnableVSYNC = false;
 		float		fFrameTimer = 1.0f;
-		float		fLastElapsed = 0.0f;
+		std::atomic<float> fLastElapsed{ 0.0f }; // Read by the renderer, which may be on its own thread
+		float		fHeadlessElapsed = 1.0f / 60.0f;
 		int			nFrameCount = 0;
 		Sprite*     fontSprite = nullptr;
 		Decal*      fontDecal = nullptr;
@@ -1136,6 +1258,40 @@ namespace olc
 		std::chrono::time_point<std::chrono::system_clock> m_tp1, m_tp2;
 		std::vector<olc::vi2d> vFontSpacing;
 
+		// Runs of set pixels in each row of each font glyph, taken from the font sheet when it is
+		// built, so text is drawn as one FillRect per run. Glyph g owns [nGlyphRunStart[g], nGlyphRunStart[g + 1])
+		struct GlyphRun { uint8_t row, x0, x1; };
+		std::vector<GlyphRun> vGlyphRuns;
+		std::array<uint16_t, 97> nGlyphRunStart = {};
+		// Draw columns [c0, c1) of glyph "g" with column c0 at "x"
+		void olc_DrawGlyph(int32_t x, int32_t y, int32_t g, int32_t c0, int32_t c1, Pixel col, uint32_t scale);
+
+		// Append a decal instance with "points" vertices to the target layer, ready for its vertices
+		// to be written. Allocates nothing once the layer has seen a frame of the same size.
+		olc::DecalInstance& AddDecalInstance(olc::Decal* decal, uint32_t points);
+
+		// Draw "w" by "h" pixels of "sprite" from ("ox", "oy") one clipped row at a time, for
+		// DrawSprite and DrawPartialSprite. The scratch buffers keep their capacity between calls
+		void olc_BlitSprite(int32_t x, int32_t y, Sprite* sprite, int32_t ox, int32_t oy, int32_t w, int32_t h, uint32_t scale, uint8_t flip);
+		std::vector<int32_t> vBlitColumns;
+		std::vector<olc::Pixel> vBlitRow;
+
+		// Frames handed from the update side to the render side. With a render thread, the update
+		// thread fills vFramePending while the render thread draws vFrameDrawn
+		bool bRenderThread = false;
+		int32_t nRendererThreads = -1; // Left to the renderer while negative
+		std::vector<LayerFrame> vFrameDrawn;
+		std::vector<LayerFrame> vFramePending;
+		float fFramePendingElapsed = 0.0f;
+		bool bFramePending = false;
+		bool bUpdateFinished = false; // Set once the update thread has handed over its last frame
+		std::mutex muxFrame;
+		std::condition_variable cvFrame;
+
+		// Frames read back from the renderer for SetFrameReader()
+		std::function<void(olc::Sprite*)> funcFrameReader;
+		olc::Sprite sprFrameRead;
+
 		// State of keyboard		
 		bool		pKeyNewState[256] = { 0 };
 		bool		pKeyOldState[256] = { 0 };
@@ -1149,6 +1305,15 @@ namespace olc
 		// The main engine thread
 		void		EngineThread();
 
+		// Frame loop stages, which olc_CoreUpdate runs back to back on one thread
+		float		olc_UpdateFrame();
+		void		olc_CaptureFrame(std::vector<LayerFrame>& frame, bool bCopyPixels);
+		void		olc_RenderFrame(std::vector<LayerFrame>& frame, float fElapsedTime);
+		void		olc_UpdateThread();
+		void		olc_RenderThread();
+		void		olc_ReadFrame();
+		void		olc_FlushFrameReads();
+
 
 		// If anything sets this flag to false, the engine
 		// "should" shut down gracefully
@@ -1337,6 +1502,7 @@ namespace olc
 		width = w;		height = h;
 		pColData.resize(width * height);
 		pColData.resize(width * height, nDefaultPixel);
+		MarkDirty();
 	}
 
 	Sprite::~Sprite()
@@ -1374,6 +1540,9 @@ namespace olc
 		if (x >= 0 && x < width && y >= 0 && y < height)
 		{
 			pColData[y * width + x] = p;
+			nDirtyTop = std::min(nDirtyTop, y);
+			nDirtyBottom = std::max(nDirtyBottom, y + 1);
+			bSolid = false;
 			return true;
 		}
 		else
@@ -1412,11 +1581,31 @@ namespace olc
 	Pixel* Sprite::GetData()
 	{ return pColData.data(); }
 
+	void Sprite::MarkDirty()
+	{ MarkDirty(0, height); }
+
+	void Sprite::MarkDirty(int32_t y0, int32_t y1)
+	{
+		y0 = std::max(y0, 0); y1 = std::min(y1, height);
+		if (y0 >= y1) return;
+		nDirtyTop = std::min(nDirtyTop, y0);
+		nDirtyBottom = std::max(nDirtyBottom, y1);
+		bSolid = false;
+	}
+
+	void Sprite::MarkClean()
+	{ nDirtyTop = height; nDirtyBottom = 0; }
+
+	bool Sprite::IsDirty() const
+	{ return nDirtyTop < nDirtyBottom; }
+
 
 	olc::rcode Sprite::LoadFromFile(const std::string& sImageFile, olc::ResourcePack* pack)
 	{
 		UNUSED(pack);
-		return loader->LoadImageResource(this, sImageFile, pack);
+		olc::rcode result = loader->LoadImageResource(this, sImageFile, pack);
+		MarkDirty();
+		return result;
 	}
 
 	olc::Sprite* Sprite::Duplicate()
@@ -1872,9 +2061,123 @@ namespace olc
 	const olc::vi2d& PixelGameEngine::GetScreenPixelSize() const
 	{ return vScreenPixelSize; }
 
+	void PixelGameEngine::SetHeadlessElapsedTime(float fElapsedTime)
+	{ fHeadlessElapsed = std::max(fElapsedTime, 0.0f); }
+
+	void PixelGameEngine::SetRenderThread(bool bEnable)
+	{ bRenderThread = bEnable; }
+
+	void PixelGameEngine::SetRendererThreads(int32_t nThreads)
+	{ nRendererThreads = nThreads; }
+
+	void PixelGameEngine::SetFrameReader(std::function<void(olc::Sprite*)> func)
+	{ funcFrameReader = func; }
+
 	const olc::vi2d& PixelGameEngine::GetWindowMouse() const
 	{ return vMouseWindowPos; }
 
+	// Pixel::ALPHA blending in 16 bit integers. The source alpha, scaled by "nBlend" (the blend
+	// factor in 8.8 fixed point), mixes source and destination, and the result is opaque. This is
+	// within 1 of the float blend it replaced, and the vector paths give exactly the scalar result
+	static Pixel BlendPixel(Pixel p, Pixel d, uint32_t nBlend)
+	{
+		uint32_t a = (p.a * nBlend + 128) >> 8;
+		uint32_t c = 255 - a;
+		// (x + 1 + (x >> 8)) >> 8 is x / 255 for every x the products can reach
+		auto Mix = [&](uint32_t s, uint32_t t) { uint32_t x = s * a + t * c; return uint8_t((x + 1 + (x >> 8)) >> 8); };
+		return Pixel(Mix(p.r, d.r), Mix(p.g, d.g), Mix(p.b, d.b));
+	}
+
+#if defined(__AVX2__)
+	// BlendPixel for 4 pixels unpacked to 16 bit channels
+	static __m256i BlendUnpacked(__m256i s, __m256i d, __m256i vBlend)
+	{
+		__m256i a = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(s, 0xFF), 0xFF);
+		a = _mm256_srli_epi16(_mm256_add_epi16(_mm256_mullo_epi16(a, vBlend), _mm256_set1_epi16(128)), 8);
+		__m256i x = _mm256_add_epi16(_mm256_mullo_epi16(s, a), _mm256_mullo_epi16(d, _mm256_sub_epi16(_mm256_set1_epi16(255), a)));
+		return _mm256_srli_epi16(_mm256_add_epi16(_mm256_add_epi16(x, _mm256_set1_epi16(1)), _mm256_srli_epi16(x, 8)), 8);
+	}
+
+	// BlendPixel for 8 pixels
+	static __m256i BlendPacked(__m256i s, __m256i d, __m256i vBlend)
+	{
+		__m256i z = _mm256_setzero_si256();
+		__m256i lo = BlendUnpacked(_mm256_unpacklo_epi8(s, z), _mm256_unpacklo_epi8(d, z), vBlend);
+		__m256i hi = BlendUnpacked(_mm256_unpackhi_epi8(s, z), _mm256_unpackhi_epi8(d, z), vBlend);
+		return _mm256_or_si256(_mm256_packus_epi16(lo, hi), _mm256_set1_epi32(int(0xFF000000)));
+	}
+#endif
+
+#if defined(__AVX__) || defined(__SSE2__) || defined(_M_X64)
+	// BlendPixel for 2 pixels unpacked to 16 bit channels
+	static __m128i BlendUnpacked(__m128i s, __m128i d, __m128i vBlend)
+	{
+		__m128i a = _mm_shufflehi_epi16(_mm_shufflelo_epi16(s, 0xFF), 0xFF);
+		a = _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(a, vBlend), _mm_set1_epi16(128)), 8);
+		__m128i x = _mm_add_epi16(_mm_mullo_epi16(s, a), _mm_mullo_epi16(d, _mm_sub_epi16(_mm_set1_epi16(255), a)));
+		return _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(x, _mm_set1_epi16(1)), _mm_srli_epi16(x, 8)), 8);
+	}
+
+	// BlendPixel for 4 pixels
+	static __m128i BlendPacked(__m128i s, __m128i d, __m128i vBlend)
+	{
+		__m128i z = _mm_setzero_si128();
+		__m128i lo = BlendUnpacked(_mm_unpacklo_epi8(s, z), _mm_unpacklo_epi8(d, z), vBlend);
+		__m128i hi = BlendUnpacked(_mm_unpackhi_epi8(s, z), _mm_unpackhi_epi8(d, z), vBlend);
+		return _mm_or_si128(_mm_packus_epi16(lo, hi), _mm_set1_epi32(int(0xFF000000)));
+	}
+#endif
+
+	// Blend "count" pixels of "src" over "dst", 8 (AVX2) or 4 (SSE2) at a time
+	static void BlendPixels(Pixel* dst, const Pixel* src, size_t count, uint32_t nBlend)
+	{
+		size_t i = 0;
+#if defined(__AVX2__)
+		__m256i vBlend8 = _mm256_set1_epi16(short(nBlend));
+		for (; i + 8 <= count; i += 8)
+		{
+			__m256i s = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+			__m256i d = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dst + i));
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), BlendPacked(s, d, vBlend8));
+		}
+#endif
+#if defined(__AVX__) || defined(__SSE2__) || defined(_M_X64)
+		__m128i vBlend4 = _mm_set1_epi16(short(nBlend));
+		for (; i + 4 <= count; i += 4)
+		{
+			__m128i s = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+			__m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), BlendPacked(s, d, vBlend4));
+		}
+#endif
+		for (; i < count; i++) dst[i] = BlendPixel(src[i], dst[i], nBlend);
+	}
+
+	// Blend "p" over "count" pixels of "dst"
+	static void BlendColour(Pixel* dst, size_t count, Pixel p, uint32_t nBlend)
+	{
+		size_t i = 0;
+#if defined(__AVX2__)
+		__m256i vBlend8 = _mm256_set1_epi16(short(nBlend));
+		__m256i s8 = _mm256_set1_epi32(int(p.n));
+		for (; i + 8 <= count; i += 8)
+		{
+			__m256i d = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dst + i));
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), BlendPacked(s8, d, vBlend8));
+		}
+#endif
+#if defined(__AVX__) || defined(__SSE2__) || defined(_M_X64)
+		__m128i vBlend4 = _mm_set1_epi16(short(nBlend));
+		__m128i s4 = _mm_set1_epi32(int(p.n));
+		for (; i + 4 <= count; i += 4)
+		{
+			__m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), BlendPacked(s4, d, vBlend4));
+		}
+#endif
+		for (; i < count; i++) dst[i] = BlendPixel(p, dst[i], nBlend);
+	}
+
 	bool PixelGameEngine::Draw(const olc::vi2d& pos, Pixel p)
 	{ return Draw(pos.x, pos.y, p); }
 
@@ -1897,12 +2200,7 @@ namespace olc
 		if (nPixelMode == Pixel::ALPHA)
 		{
 			Pixel d = pDrawTarget->GetPixel(x, y);
-			float a = (float)(p.a / 255.0f) * fBlendFactor;
-			float c = 1.0f - a;
-			float r = a * (float)p.r + c * (float)d.r;
-			float g = a * (float)p.g + c * (float)d.g;
-			float b = a * (float)p.b + c * (float)d.b;
-			return pDrawTarget->SetPixel(x, y, Pixel((uint8_t)r, (uint8_t)g, (uint8_t)b/*, (uint8_t)(p.a * fBlendFactor)*/));
+			return pDrawTarget->SetPixel(x, y, BlendPixel(p, d, nBlendFactor));
 		}
 
 		if (nPixelMode == Pixel::CUSTOM)
@@ -2094,11 +2392,41 @@ namespace olc
 		DrawLine(x, y + h, x, y, p);
 	}
 
+	// Set "count" pixels from "dst" to "p", 8 (AVX) or 4 (SSE2) at a time once "dst" is aligned.
+	// Streaming stores bypass the cache, which suits fills too large to stay in it anyway
+	static void FillPixels(Pixel* dst, size_t count, Pixel p, bool bStream)
+	{
+		size_t i = 0;
+#if defined(__AVX__)
+		for (; i < count && (reinterpret_cast<uintptr_t>(dst + i) & 31); i++) dst[i] = p;
+		__m256i v8 = _mm256_set1_epi32(int(p.n));
+		if (bStream)
+			for (; i + 8 <= count; i += 8) _mm256_stream_si256(reinterpret_cast<__m256i*>(dst + i), v8);
+		else
+			for (; i + 8 <= count; i += 8) _mm256_store_si256(reinterpret_cast<__m256i*>(dst + i), v8);
+#endif
+#if defined(__AVX__) || defined(__SSE2__) || defined(_M_X64)
+		for (; i < count && (reinterpret_cast<uintptr_t>(dst + i) & 15); i++) dst[i] = p;
+		__m128i v4 = _mm_set1_epi32(int(p.n));
+		if (bStream)
+			for (; i + 4 <= count; i += 4) _mm_stream_si128(reinterpret_cast<__m128i*>(dst + i), v4);
+		else
+			for (; i + 4 <= count; i += 4) _mm_store_si128(reinterpret_cast<__m128i*>(dst + i), v4);
+		// Streaming stores are weakly ordered, make them visible before anyone reads the pixels
+		if (bStream) _mm_sfence();
+#endif
+		for (; i < count; i++) dst[i] = p;
+	}
+
 	void PixelGameEngine::Clear(Pixel p)
 	{
-		int pixels = GetDrawTargetWidth() * GetDrawTargetHeight();
-		Pixel* m = GetDrawTarget()->GetData();
-		for (int i = 0; i < pixels; i++) m[i] = p;
+		Sprite* target = GetDrawTarget();
+		// Nothing has been drawn since the target was last cleared to this colour
+		if (target->bSolid && target->pSolid == p) return;
+		FillPixels(target->GetData(), size_t(target->width) * size_t(target->height), p, true);
+		target->MarkDirty();
+		target->bSolid = true;
+		target->pSolid = p;
 	}
 
 	void PixelGameEngine::ClearBuffer(Pixel p, bool bDepth)
@@ -2159,6 +2487,25 @@ namespace olc
 		if (y2 < 0) y2 = 0;
 		if (y2 >= (int32_t)GetDrawTargetHeight()) y2 = (int32_t)GetDrawTargetHeight();
 
+		if (x >= x2 || y >= y2) return;
+
+		// Plain writes fill whole clipped rows at once, other modes blend pixel by pixel
+		if (nPixelMode == Pixel::NORMAL || (nPixelMode == Pixel::MASK && p.a == 255))
+		{
+			for (int j = y; j < y2; j++)
+				FillPixels(pDrawTarget->GetData() + size_t(j) * pDrawTarget->width + x, size_t(x2 - x), p, false);
+			pDrawTarget->MarkDirty(y, y2);
+			return;
+		}
+
+		if (nPixelMode == Pixel::ALPHA)
+		{
+			for (int j = y; j < y2; j++)
+				BlendColour(pDrawTarget->GetData() + size_t(j) * pDrawTarget->width + x, size_t(x2 - x), p, nBlendFactor);
+			pDrawTarget->MarkDirty(y, y2);
+			return;
+		}
+
 		for (int i = x; i < x2; i++)
 			for (int j = y; j < y2; j++)
 				Draw(i, j, p);
@@ -2320,70 +2667,163 @@ namespace olc
 	{
 		if (sprite == nullptr)
 			return;
+		olc_BlitSprite(x, y, sprite, 0, 0, sprite->width, sprite->height, scale, flip);
+	}
 
-		int32_t fxs = 0, fxm = 1, fx = 0;
-		int32_t fys = 0, fym = 1, fy = 0;
-		if (flip & olc::Sprite::Flip::HORIZ) { fxs = sprite->width - 1; fxm = -1; }
-		if (flip & olc::Sprite::Flip::VERT) { fys = sprite->height - 1; fym = -1; }
+	void PixelGameEngine::DrawPartialSprite(const olc::vi2d& pos, Sprite* sprite, const olc::vi2d& sourcepos, const olc::vi2d& size, uint32_t scale, uint8_t flip)
+	{ DrawPartialSprite(pos.x, pos.y, sprite, sourcepos.x, sourcepos.y, size.x, size.y, scale, flip); }
 
-		if (scale > 1)
-		{
-			fx = fxs;
-			for (int32_t i = 0; i < sprite->width; i++, fx += fxm)
+	void PixelGameEngine::DrawPartialSprite(int32_t x, int32_t y, Sprite* sprite, int32_t ox, int32_t oy, int32_t w, int32_t h, uint32_t scale, uint8_t flip)
+	{
+		if (sprite == nullptr)
+			return;
+		olc_BlitSprite(x, y, sprite, ox, oy, w, h, scale, flip);
+	}
+
+	void PixelGameEngine::olc_BlitSprite(int32_t x, int32_t y, Sprite* sprite, int32_t ox, int32_t oy, int32_t w, int32_t h, uint32_t scale, uint8_t flip)
+	{
+		if (pDrawTarget == nullptr || w <= 0 || h <= 0) return;
+		int32_t s = std::max(int32_t(scale), 1);
+
+		// Clip the scaled rectangle to the target once
+		int32_t cx0 = std::max(x, 0);
+		int32_t cy0 = std::max(y, 0);
+		int32_t cx1 = std::min(x + w * s, pDrawTarget->width);
+		int32_t cy1 = std::min(y + h * s, pDrawTarget->height);
+		if (cx0 >= cx1 || cy0 >= cy1) return;
+		int32_t cw = cx1 - cx0;
+
+		// Source column of each target column, with scale and flip applied
+		vBlitColumns.resize(cw);
+		bool bColumnsInside = true;
+		for (int32_t k = 0; k < cw; k++)
+		{
+			int32_t i = (cx0 + k - x) / s;
+			int32_t sx = ((flip & olc::Sprite::Flip::HORIZ) ? w - 1 - i : i) + ox;
+			vBlitColumns[k] = sx;
+			bColumnsInside &= sx >= 0 && sx < sprite->width;
+		}
+		bool bContiguous = s == 1 && !(flip & olc::Sprite::Flip::HORIZ);
+
+		// Rows that stay inside the sprite are read in place, the rest are sampled through
+		// GetPixel() so wrapping, clamping and out of range pixels behave as with Draw()
+		const olc::Pixel* pRow = nullptr;
+		int32_t nGathered = -1;
+		vBlitRow.resize(cw);
+		for (int32_t dy = cy0; dy < cy1; dy++)
+		{
+			int32_t j = (dy - y) / s;
+			int32_t sy = ((flip & olc::Sprite::Flip::VERT) ? h - 1 - j : j) + oy;
+			bool bInside = bColumnsInside && sy >= 0 && sy < sprite->height && sprite->modeSample == olc::Sprite::Mode::NORMAL;
+			if (bInside && bContiguous)
+				pRow = sprite->GetData() + size_t(sy) * sprite->width + vBlitColumns[0];
+			else
 			{
-				fy = fys;
-				for (int32_t j = 0; j < sprite->height; j++, fy += fym)
-					for (uint32_t is = 0; is < scale; is++)
-						for (uint32_t js = 0; js < scale; js++)
-							Draw(x + (i * scale) + is, y + (j * scale) + js, sprite->GetPixel(fx, fy));
+				if (sy != nGathered || pRow != vBlitRow.data())
+				{
+					if (bInside)
+					{
+						const olc::Pixel* pSource = sprite->GetData() + size_t(sy) * sprite->width;
+						for (int32_t k = 0; k < cw; k++) vBlitRow[k] = pSource[vBlitColumns[k]];
+					}
+					else
+						for (int32_t k = 0; k < cw; k++) vBlitRow[k] = sprite->GetPixel(vBlitColumns[k], sy);
+					nGathered = sy;
+				}
+				pRow = vBlitRow.data();
 			}
-		}
-		else
-		{
-			fx = fxs;
-			for (int32_t i = 0; i < sprite->width; i++, fx += fxm)
+
+			olc::Pixel* pDst = pDrawTarget->GetData() + size_t(dy) * pDrawTarget->width + cx0;
+			switch (nPixelMode)
 			{
-				fy = fys;
-				for (int32_t j = 0; j < sprite->height; j++, fy += fym)
-					Draw(x + i, y + j, sprite->GetPixel(fx, fy));
+			case Pixel::NORMAL:
+				// memmove, as a sprite may be drawn onto itself
+				std::memmove(pDst, pRow, sizeof(olc::Pixel) * cw);
+				break;
+			case Pixel::MASK:
+				// A select rather than a branch, which the compiler can vectorise
+				for (int32_t k = 0; k < cw; k++)
+					pDst[k] = pRow[k].a == 255 ? pRow[k] : pDst[k];
+				break;
+			case Pixel::ALPHA:
+				BlendPixels(pDst, pRow, size_t(cw), nBlendFactor);
+				break;
+			case Pixel::CUSTOM:
+				for (int32_t k = 0; k < cw; k++)
+					pDst[k] = funcPixelMode(cx0 + k, dy, pRow[k], pDst[k]);
+				break;
 			}
 		}
+		pDrawTarget->MarkDirty(cy0, cy1);
 	}
 
-	void PixelGameEngine::DrawPartialSprite(const olc::vi2d& pos, Sprite* sprite, const olc::vi2d& sourcepos, const olc::vi2d& size, uint32_t scale, uint8_t flip)
-	{ DrawPartialSprite(pos.x, pos.y, sprite, sourcepos.x, sourcepos.y, size.x, size.y, scale, flip); }
-
-	void PixelGameEngine::DrawPartialSprite(int32_t x, int32_t y, Sprite* sprite, int32_t ox, int32_t oy, int32_t w, int32_t h, uint32_t scale, uint8_t flip)
+	olc::DecalInstance& PixelGameEngine::AddDecalInstance(olc::Decal* decal, uint32_t points)
 	{
-		if (sprite == nullptr)
-			return;
+		LayerDesc& layer = vLayers[nTargetLayer];
+		layer.vecDecalInstance.emplace_back();
+		DecalInstance& di = layer.vecDecalInstance.back();
+		di.decal = decal;
+		di.points = points;
+		di.mode = nDecalMode;
+		di.structure = nDecalStructure;
+		if (points > DecalInstance::nInlinePoints)
+		{
+			DecalVertexArena& arena = layer.decalArena;
+			di.nArenaOffset = uint32_t(arena.pos.size());
+			arena.pos.resize(di.nArenaOffset + points);
+			arena.uv.resize(di.nArenaOffset + points);
+			arena.w.resize(di.nArenaOffset + points);
+			arena.tint.resize(di.nArenaOffset + points);
+		}
+		layer.decalArena.Bind(di);
+		return di;
+	}
 
-		int32_t fxs = 0, fxm = 1, fx = 0;
-		int32_t fys = 0, fym = 1, fy = 0;
-		if (flip & olc::Sprite::Flip::HORIZ) { fxs = w - 1; fxm = -1; }
-		if (flip & olc::Sprite::Flip::VERT) { fys = h - 1; fym = -1; }
+	// Axis aligned quad from corner "tl" to "br", in the vertex order every decal quad uses.
+	static void SetQuad(olc::DecalInstance& di, const olc::vf2d& tl, const olc::vf2d& br, const olc::vf2d& uvtl, const olc::vf2d& uvbr, const olc::Pixel& tint)
+	{
+		di.pos[0] = { tl.x, tl.y }; di.pos[1] = { tl.x, br.y }; di.pos[2] = { br.x, br.y }; di.pos[3] = { br.x, tl.y };
+		di.uv[0] = { uvtl.x, uvtl.y }; di.uv[1] = { uvtl.x, uvbr.y }; di.uv[2] = { uvbr.x, uvbr.y }; di.uv[3] = { uvbr.x, uvtl.y };
+		for (int i = 0; i < 4; i++) { di.w[i] = 1.0f; di.tint[i] = tint; }
+	}
 
-		if (scale > 1)
+	// Calls "vertex" with the index of each vertex of "decal" as it appears in a triangle list, or
+	// in a line loop for wireframes, so renderers can merge many decals into one draw call
+	template<typename F>
+	static void ForEachBatchedVertex(const olc::DecalInstance& decal, F vertex)
+	{
+		if (decal.mode == olc::DecalMode::WIREFRAME || decal.structure == olc::DecalStructure::LIST)
+		{
+			for (uint32_t i = 0; i < decal.points; i++) vertex(i);
+		}
+		else if (decal.structure == olc::DecalStructure::STRIP)
 		{
-			fx = fxs;
-			for (int32_t i = 0; i < w; i++, fx += fxm)
+			// Alternate the winding so every triangle keeps the strip's orientation
+			for (uint32_t i = 0; i + 2 < decal.points; i++)
 			{
-				fy = fys;
-				for (int32_t j = 0; j < h; j++, fy += fym)
-					for (uint32_t is = 0; is < scale; is++)
-						for (uint32_t js = 0; js < scale; js++)
-							Draw(x + (i * scale) + is, y + (j * scale) + js, sprite->GetPixel(fx + ox, fy + oy));
+				if (i & 1) { vertex(i + 1); vertex(i); } else { vertex(i); vertex(i + 1); }
+				vertex(i + 2);
 			}
 		}
 		else
 		{
-			fx = fxs;
-			for (int32_t i = 0; i < w; i++, fx += fxm)
-			{
-				fy = fys;
-				for (int32_t j = 0; j < h; j++, fy += fym)
-					Draw(x + i, y + j, sprite->GetPixel(fx + ox, fy + oy));
-			}
+			for (uint32_t i = 1; i + 1 < decal.points; i++) { vertex(0); vertex(i); vertex(i + 1); }
+		}
+	}
+
+	// Calls "draw" with each run [first, last) of consecutive decals that share a texture and blend mode.
+	// Runs are never reordered, since overlapping decals must blend in the order they were drawn.
+	// Wireframes are line loops that cannot be joined, so they are always a run of their own
+	template<typename T, typename F>
+	static void ForEachDecalRun(const olc::DecalInstance* decals, size_t count, T texture, F draw)
+	{
+		for (size_t i = 0; i < count;)
+		{
+			size_t j = i + 1;
+			if (decals[i].mode != olc::DecalMode::WIREFRAME)
+				while (j < count && decals[j].mode == decals[i].mode && texture(decals[j]) == texture(decals[i])) j++;
+			draw(i, j);
+			i = j;
 		}
 	}
 
@@ -2412,18 +2852,10 @@ namespace olc
 		olc::vf2d vQuantisedPos = ((vScreenSpacePos * vWindow) + olc::vf2d(0.5f, 0.5f)).floor() / vWindow;
 		olc::vf2d vQuantisedDim = ((vScreenSpaceDim * vWindow) + olc::vf2d(0.5f, -0.5f)).ceil() / vWindow;
 
-		DecalInstance di;
-		di.points = 4;
-		di.decal = decal;
-		di.tint = { tint, tint, tint, tint };
-		di.pos = { { vQuantisedPos.x, vQuantisedPos.y }, { vQuantisedPos.x, vQuantisedDim.y }, { vQuantisedDim.x, vQuantisedDim.y }, { vQuantisedDim.x, vQuantisedPos.y } };
 		olc::vf2d uvtl = (source_pos + olc::vf2d(0.0001f, 0.0001f)) * decal->vUVScale;
 		olc::vf2d uvbr = (source_pos + source_size - olc::vf2d(0.0001f, 0.0001f)) * decal->vUVScale;
-		di.uv = { { uvtl.x, uvtl.y }, { uvtl.x, uvbr.y }, { uvbr.x, uvbr.y }, { uvbr.x, uvtl.y } };
-		di.w = { 1,1,1,1 };
-		di.mode = nDecalMode;
-		di.structure = nDecalStructure;
-		vLayers[nTargetLayer].vecDecalInstance.push_back(di);
+		DecalInstance& di = AddDecalInstance(decal, 4);
+		SetQuad(di, vQuantisedPos, vQuantisedDim, uvtl, uvbr, tint);
 	}
 
 	void PixelGameEngine::DrawPartialDecal(const olc::vf2d& pos, const olc::vf2d& size, olc::Decal* decal, const olc::vf2d& source_pos, const olc::vf2d& source_size, const olc::Pixel& tint)
@@ -2440,18 +2872,10 @@ namespace olc
 			vScreenSpacePos.y - (2.0f * size.y * vInvScreenSize.y)
 		};
 
-		DecalInstance di;
-		di.points = 4;
-		di.decal = decal;
-		di.tint = { tint, tint, tint, tint };
-		di.pos = { { vScreenSpacePos.x, vScreenSpacePos.y }, { vScreenSpacePos.x, vScreenSpaceDim.y }, { vScreenSpaceDim.x, vScreenSpaceDim.y }, { vScreenSpaceDim.x, vScreenSpacePos.y } };
 		olc::vf2d uvtl = (source_pos) * decal->vUVScale;
 		olc::vf2d uvbr = uvtl + ((source_size) * decal->vUVScale);
-		di.uv = { { uvtl.x, uvtl.y }, { uvtl.x, uvbr.y }, { uvbr.x, uvbr.y }, { uvbr.x, uvtl.y } };
-		di.w = { 1,1,1,1 };
-		di.mode = nDecalMode;
-		di.structure = nDecalStructure;
-		vLayers[nTargetLayer].vecDecalInstance.push_back(di);
+		DecalInstance& di = AddDecalInstance(decal, 4);
+		SetQuad(di, vScreenSpacePos, vScreenSpaceDim, uvtl, uvbr, tint);
 	}
 
 
@@ -2469,27 +2893,13 @@ namespace olc
 			vScreenSpacePos.y - (2.0f * (float(decal->sprite->height) * vInvScreenSize.y)) * scale.y
 		};
 
-		DecalInstance di;
-		di.decal = decal;
-		di.points = 4;
-		di.tint = { tint, tint, tint, tint };
-		di.pos = { { vScreenSpacePos.x, vScreenSpacePos.y }, { vScreenSpacePos.x, vScreenSpaceDim.y }, { vScreenSpaceDim.x, vScreenSpaceDim.y }, { vScreenSpaceDim.x, vScreenSpacePos.y } };
-		di.uv = { { 0.0f, 0.0f}, {0.0f, 1.0f}, {1.0f, 1.0f}, {1.0f, 0.0f} };
-		di.w = { 1, 1, 1, 1 };
-		di.mode = nDecalMode;
-		di.structure = nDecalStructure;
-		vLayers[nTargetLayer].vecDecalInstance.push_back(di);
+		DecalInstance& di = AddDecalInstance(decal, 4);
+		SetQuad(di, vScreenSpacePos, vScreenSpaceDim, { 0.0f, 0.0f }, { 1.0f, 1.0f }, tint);
 	}
 
 	void PixelGameEngine::DrawExplicitDecal(olc::Decal* decal, const olc::vf2d* pos, const olc::vf2d* uv, const olc::Pixel* col, uint32_t elements)
 	{
-		DecalInstance di;
-		di.decal = decal;
-		di.pos.resize(elements);
-		di.uv.resize(elements);
-		di.w.resize(elements);
-		di.tint.resize(elements);
-		di.points = elements;
+		DecalInstance& di = AddDecalInstance(decal, elements);
 		for (uint32_t i = 0; i < elements; i++)
 		{
 			di.pos[i] = { (pos[i].x * vInvScreenSize.x) * 2.0f - 1.0f, ((pos[i].y * vInvScreenSize.y) * 2.0f - 1.0f) * -1.0f };
@@ -2497,20 +2907,11 @@ namespace olc
 			di.tint[i] = col[i];
 			di.w[i] = 1.0f;
 		}
-		di.mode = nDecalMode;
-		di.structure = nDecalStructure;
-		vLayers[nTargetLayer].vecDecalInstance.push_back(di);
 	}
 
 	void PixelGameEngine::DrawPolygonDecal(olc::Decal* decal, const std::vector<olc::vf2d>& pos, const std::vector<olc::vf2d>& uv, const olc::Pixel tint)
 	{
-		DecalInstance di;
-		di.decal = decal;
-		di.points = uint32_t(pos.size());
-		di.pos.resize(di.points);
-		di.uv.resize(di.points);
-		di.w.resize(di.points);
-		di.tint.resize(di.points);
+		DecalInstance& di = AddDecalInstance(decal, uint32_t(pos.size()));
 		for (uint32_t i = 0; i < di.points; i++)
 		{
 			di.pos[i] = { (pos[i].x * vInvScreenSize.x) * 2.0f - 1.0f, ((pos[i].y * vInvScreenSize.y) * 2.0f - 1.0f) * -1.0f };
@@ -2518,20 +2919,11 @@ namespace olc
 			di.tint[i] = tint;
 			di.w[i] = 1.0f;
 		}
-		di.mode = nDecalMode;
-		di.structure = nDecalStructure;
-		vLayers[nTargetLayer].vecDecalInstance.push_back(di);
 	}
 
 	void PixelGameEngine::DrawPolygonDecal(olc::Decal* decal, const std::vector<olc::vf2d>& pos, const std::vector<olc::vf2d>& uv, const std::vector<olc::Pixel> &tint)
 	{
-		DecalInstance di;
-		di.decal = decal;
-		di.points = uint32_t(pos.size());
-		di.pos.resize(di.points);
-		di.uv.resize(di.points);
-		di.w.resize(di.points);
-		di.tint.resize(di.points);
+		DecalInstance& di = AddDecalInstance(decal, uint32_t(pos.size()));
 		for (uint32_t i = 0; i < di.points; i++)
 		{
 			di.pos[i] = { (pos[i].x * vInvScreenSize.x) * 2.0f - 1.0f, ((pos[i].y * vInvScreenSize.y) * 2.0f - 1.0f) * -1.0f };
@@ -2539,20 +2931,11 @@ namespace olc
 			di.tint[i] = tint[i];
 			di.w[i] = 1.0f;
 		}
-		di.mode = nDecalMode;
-		di.structure = nDecalStructure;
-		vLayers[nTargetLayer].vecDecalInstance.push_back(di);
 	}
 
 	void PixelGameEngine::DrawPolygonDecal(olc::Decal* decal, const std::vector<olc::vf2d>& pos, const std::vector<float>& depth, const std::vector<olc::vf2d>& uv, const olc::Pixel tint)
 	{
-		DecalInstance di;
-		di.decal = decal;
-		di.points = uint32_t(pos.size());
-		di.pos.resize(di.points);
-		di.uv.resize(di.points);
-		di.w.resize(di.points);
-		di.tint.resize(di.points);
+		DecalInstance& di = AddDecalInstance(decal, uint32_t(pos.size()));
 		for (uint32_t i = 0; i < di.points; i++)
 		{
 			di.pos[i] = { (pos[i].x * vInvScreenSize.x) * 2.0f - 1.0f, ((pos[i].y * vInvScreenSize.y) * 2.0f - 1.0f) * -1.0f };
@@ -2560,22 +2943,13 @@ namespace olc
 			di.tint[i] = tint;
 			di.w[i] = 1.0f;
 		}
-		di.mode = nDecalMode;
-		di.structure = nDecalStructure;
-		vLayers[nTargetLayer].vecDecalInstance.push_back(di);
 	}
 
 #ifdef OLC_ENABLE_EXPERIMENTAL
 	// Lightweight 3D
 	void PixelGameEngine::LW3D_DrawTriangles(olc::Decal* decal, const std::vector<std::array<float, 3>>& pos, const std::vector<olc::vf2d>& tex, const std::vector<olc::Pixel>& col)
 	{
-		DecalInstance di;
-		di.decal = decal;
-		di.points = uint32_t(pos.size());
-		di.pos.resize(di.points);
-		di.uv.resize(di.points);
-		di.w.resize(di.points);
-		di.tint.resize(di.points);
+		DecalInstance& di = AddDecalInstance(decal, uint32_t(pos.size()));
 		for (uint32_t i = 0; i < di.points; i++)
 		{
 			di.pos[i] = { pos[i][0], pos[i][1] };
@@ -2584,19 +2958,13 @@ namespace olc
 			di.tint[i] = col[i];			
 		}
 		di.mode = DecalMode::MODEL3D;
-		vLayers[nTargetLayer].vecDecalInstance.push_back(di);
+		di.structure = DecalStructure::FAN;
 	}
 #endif
 
 	void PixelGameEngine::DrawLineDecal(const olc::vf2d& pos1, const olc::vf2d& pos2, Pixel p)
 	{
-		DecalInstance di;
-		di.decal = nullptr;
-		di.points = uint32_t(2);
-		di.pos.resize(di.points);
-		di.uv.resize(di.points);
-		di.w.resize(di.points);
-		di.tint.resize(di.points);
+		DecalInstance& di = AddDecalInstance(nullptr, 2);
 		di.pos[0] = { (pos1.x * vInvScreenSize.x) * 2.0f - 1.0f, ((pos1.y * vInvScreenSize.y) * 2.0f - 1.0f) * -1.0f };
 		di.uv[0] = { 0.0f, 0.0f };
 		di.tint[0] = p;
@@ -2606,7 +2974,7 @@ namespace olc
 		di.tint[1] = p;
 		di.w[1] = 1.0f;
 		di.mode = olc::DecalMode::WIREFRAME;
-		vLayers[nTargetLayer].vecDecalInstance.push_back(di);
+		di.structure = olc::DecalStructure::FAN;
 	}
 
 	void PixelGameEngine::FillRectDecal(const olc::vf2d& pos, const olc::vf2d& size, const olc::Pixel col)
@@ -2628,13 +2996,8 @@ namespace olc
 
 	void PixelGameEngine::DrawRotatedDecal(const olc::vf2d& pos, olc::Decal* decal, const float fAngle, const olc::vf2d& center, const olc::vf2d& scale, const olc::Pixel& tint)
 	{
-		DecalInstance di;
-		di.decal = decal;
-		di.pos.resize(4);
-		di.uv = { { 0.0f, 0.0f}, {0.0f, 1.0f}, {1.0f, 1.0f}, {1.0f, 0.0f} };
-		di.w = { 1, 1, 1, 1 };
-		di.tint = { tint, tint, tint, tint };
-		di.points = 4;
+		DecalInstance& di = AddDecalInstance(decal, 4);
+		SetQuad(di, {}, {}, { 0.0f, 0.0f }, { 1.0f, 1.0f }, tint);
 		di.pos[0] = (olc::vf2d(0.0f, 0.0f) - center) * scale;
 		di.pos[1] = (olc::vf2d(0.0f, float(decal->sprite->height)) - center) * scale;
 		di.pos[2] = (olc::vf2d(float(decal->sprite->width), float(decal->sprite->height)) - center) * scale;
@@ -2645,22 +3008,16 @@ namespace olc
 			di.pos[i] = pos + olc::vf2d(di.pos[i].x * c - di.pos[i].y * s, di.pos[i].x * s + di.pos[i].y * c);
 			di.pos[i] = di.pos[i] * vInvScreenSize * 2.0f - olc::vf2d(1.0f, 1.0f);
 			di.pos[i].y *= -1.0f;
-			di.w[i] = 1;
 		}
-		di.mode = nDecalMode;
-		di.structure = nDecalStructure;
-		vLayers[nTargetLayer].vecDecalInstance.push_back(di);
 	}
 
 
 	void PixelGameEngine::DrawPartialRotatedDecal(const olc::vf2d& pos, olc::Decal* decal, const float fAngle, const olc::vf2d& center, const olc::vf2d& source_pos, const olc::vf2d& source_size, const olc::vf2d& scale, const olc::Pixel& tint)
 	{
-		DecalInstance di;
-		di.decal = decal;
-		di.points = 4;
-		di.tint = { tint, tint, tint, tint };
-		di.w = { 1, 1, 1, 1 };
-		di.pos.resize(4);
+		olc::vf2d uvtl = source_pos * decal->vUVScale;
+		olc::vf2d uvbr = uvtl + (source_size * decal->vUVScale);
+		DecalInstance& di = AddDecalInstance(decal, 4);
+		SetQuad(di, {}, {}, uvtl, uvbr, tint);
 		di.pos[0] = (olc::vf2d(0.0f, 0.0f) - center) * scale;
 		di.pos[1] = (olc::vf2d(0.0f, source_size.y) - center) * scale;
 		di.pos[2] = (olc::vf2d(source_size.x, source_size.y) - center) * scale;
@@ -2672,31 +3029,18 @@ namespace olc
 			di.pos[i] = di.pos[i] * vInvScreenSize * 2.0f - olc::vf2d(1.0f, 1.0f);
 			di.pos[i].y *= -1.0f;
 		}
-
-		olc::vf2d uvtl = source_pos * decal->vUVScale;
-		olc::vf2d uvbr = uvtl + (source_size * decal->vUVScale);
-		di.uv = { { uvtl.x, uvtl.y }, { uvtl.x, uvbr.y }, { uvbr.x, uvbr.y }, { uvbr.x, uvtl.y } };
-		di.mode = nDecalMode;
-		di.structure = nDecalStructure;
-		vLayers[nTargetLayer].vecDecalInstance.push_back(di);
 	}
 
 	void PixelGameEngine::DrawPartialWarpedDecal(olc::Decal* decal, const olc::vf2d* pos, const olc::vf2d& source_pos, const olc::vf2d& source_size, const olc::Pixel& tint)
 	{
-		DecalInstance di;
-		di.points = 4;
-		di.decal = decal;
-		di.tint = { tint, tint, tint, tint };
-		di.w = { 1, 1, 1, 1 };
-		di.pos.resize(4);
-		di.uv = { { 0.0f, 0.0f}, {0.0f, 1.0f}, {1.0f, 1.0f}, {1.0f, 0.0f} };
 		olc::vf2d center;
 		float rd = ((pos[2].x - pos[0].x) * (pos[3].y - pos[1].y) - (pos[3].x - pos[1].x) * (pos[2].y - pos[0].y));
 		if (rd != 0)
 		{
 			olc::vf2d uvtl = source_pos * decal->vUVScale;
 			olc::vf2d uvbr = uvtl + (source_size * decal->vUVScale);
-			di.uv = { { uvtl.x, uvtl.y }, { uvtl.x, uvbr.y }, { uvbr.x, uvbr.y }, { uvbr.x, uvtl.y } };
+			DecalInstance& di = AddDecalInstance(decal, 4);
+			SetQuad(di, {}, {}, uvtl, uvbr, tint);
 
 			rd = 1.0f / rd;
 			float rn = ((pos[3].x - pos[1].x) * (pos[0].y - pos[1].y) - (pos[3].y - pos[1].y) * (pos[0].x - pos[1].x)) * rd;
@@ -2709,9 +3053,6 @@ namespace olc
 				di.uv[i] *= q; di.w[i] *= q;
 				di.pos[i] = { (pos[i].x * vInvScreenSize.x) * 2.0f - 1.0f, ((pos[i].y * vInvScreenSize.y) * 2.0f - 1.0f) * -1.0f };
 			}
-			di.mode = nDecalMode;
-			di.structure = nDecalStructure;
-			vLayers[nTargetLayer].vecDecalInstance.push_back(di);
 		}
 	}
 
@@ -2719,17 +3060,12 @@ namespace olc
 	{
 		// Thanks Nathan Reed, a brilliant article explaining whats going on here
 		// http://www.reedbeta.com/blog/quadrilateral-interpolation-part-1/
-		DecalInstance di;
-		di.points = 4;
-		di.decal = decal;
-		di.tint = { tint, tint, tint, tint };
-		di.w = { 1, 1, 1, 1 };
-		di.pos.resize(4);
-		di.uv = { { 0.0f, 0.0f}, {0.0f, 1.0f}, {1.0f, 1.0f}, {1.0f, 0.0f} };
 		olc::vf2d center;
 		float rd = ((pos[2].x - pos[0].x) * (pos[3].y - pos[1].y) - (pos[3].x - pos[1].x) * (pos[2].y - pos[0].y));
 		if (rd != 0)
 		{
+			DecalInstance& di = AddDecalInstance(decal, 4);
+			SetQuad(di, {}, {}, { 0.0f, 0.0f }, { 1.0f, 1.0f }, tint);
 			rd = 1.0f / rd;
 			float rn = ((pos[3].x - pos[1].x) * (pos[0].y - pos[1].y) - (pos[3].y - pos[1].y) * (pos[0].x - pos[1].x)) * rd;
 			float sn = ((pos[2].x - pos[0].x) * (pos[0].y - pos[1].y) - (pos[2].y - pos[0].y) * (pos[0].x - pos[1].x)) * rd;
@@ -2741,9 +3077,6 @@ namespace olc
 				di.uv[i] *= q; di.w[i] *= q;
 				di.pos[i] = { (pos[i].x * vInvScreenSize.x) * 2.0f - 1.0f, ((pos[i].y * vInvScreenSize.y) * 2.0f - 1.0f) * -1.0f };
 			}
-			di.mode = nDecalMode;
-			di.structure = nDecalStructure;
-			vLayers[nTargetLayer].vecDecalInstance.push_back(di);
 		}
 	}
 
@@ -2892,25 +3225,7 @@ namespace olc
 			}
 			else			
 			{
-				int32_t ox = (c - 32) % 16;
-				int32_t oy = (c - 32) / 16;
-
-				if (scale > 1)
-				{
-					for (uint32_t i = 0; i < 8; i++)
-						for (uint32_t j = 0; j < 8; j++)
-							if (fontSprite->GetPixel(i + ox * 8, j + oy * 8).r > 0)
-								for (uint32_t is = 0; is < scale; is++)
-									for (uint32_t js = 0; js < scale; js++)
-										Draw(x + sx + (i * scale) + is, y + sy + (j * scale) + js, col);
-				}
-				else
-				{
-					for (uint32_t i = 0; i < 8; i++)
-						for (uint32_t j = 0; j < 8; j++)
-							if (fontSprite->GetPixel(i + ox * 8, j + oy * 8).r > 0)
-								Draw(x + sx + i, y + sy + j, col);
-				}
+				olc_DrawGlyph(x + sx, y + sy, c - 32, 0, 8, col, scale);
 				sx += 8 * scale;
 			}
 		}
@@ -2960,26 +3275,9 @@ namespace olc
 			}
 			else
 			{
-				int32_t ox = (c - 32) % 16;
-				int32_t oy = (c - 32) / 16;
-
-				if (scale > 1)
-				{
-					for (int32_t i = 0; i < vFontSpacing[c - 32].y; i++)
-						for (int32_t j = 0; j < 8; j++)
-							if (fontSprite->GetPixel(i + ox * 8 + vFontSpacing[c - 32].x, j + oy * 8).r > 0)
-								for (int32_t is = 0; is < int(scale); is++)
-									for (int32_t js = 0; js < int(scale); js++)
-										Draw(x + sx + (i * scale) + is, y + sy + (j * scale) + js, col);
-				}
-				else
-				{
-					for (int32_t i = 0; i < vFontSpacing[c - 32].y; i++)
-						for (int32_t j = 0; j < 8; j++)
-							if (fontSprite->GetPixel(i + ox * 8 + vFontSpacing[c - 32].x, j + oy * 8).r > 0)
-								Draw(x + sx + i, y + sy + j, col);
-				}
-				sx += vFontSpacing[c - 32].y * scale;
+				const olc::vi2d& spacing = vFontSpacing[c - 32];
+				olc_DrawGlyph(x + sx, y + sy, c - 32, spacing.x, spacing.x + spacing.y, col, scale);
+				sx += spacing.y * scale;
 			}
 		}
 		SetPixelMode(m);
@@ -3002,6 +3300,7 @@ namespace olc
 		fBlendFactor = fBlend;
 		if (fBlendFactor < 0.0f) fBlendFactor = 0.0f;
 		if (fBlendFactor > 1.0f) fBlendFactor = 1.0f;
+		nBlendFactor = uint32_t(fBlendFactor * 256.0f + 0.5f);
 	}
 
 	// User must override these functions as required. I have not made
@@ -3050,14 +3349,18 @@ namespace olc
 	}
 
 	void PixelGameEngine::olc_UpdateMouseWheel(int32_t delta)
-	{ nMouseWheelDeltaCache += delta; }
+	{
+		std::lock_guard<std::mutex> lock(muxInput);
+		nMouseWheelDeltaCache += delta;
+	}
 
 	void PixelGameEngine::olc_UpdateMouse(int32_t x, int32_t y)
 	{
 		// Mouse coords come in screen space
 		// But leave in pixel space
 		bHasMouseFocus = true;
-		vMouseWindowPos = { x, y };
+		std::lock_guard<std::mutex> lock(muxInput);
+		vMouseWindowPosCache = { x, y };
 		// Full Screen mode may have a weird viewport we must clamp to
 		x -= vViewPos.x;
 		y -= vViewPos.y;
@@ -3070,10 +3373,16 @@ namespace olc
 	}
 
 	void PixelGameEngine::olc_UpdateMouseState(int32_t button, bool state)
-	{ pMouseNewState[button] = state; }
+	{
+		std::lock_guard<std::mutex> lock(muxInput);
+		pMouseNewState[button] = state;
+	}
 
 	void PixelGameEngine::olc_UpdateKeyState(int32_t key, bool state)
-	{ pKeyNewState[key] = state; }
+	{
+		std::lock_guard<std::mutex> lock(muxInput);
+		pKeyNewState[key] = state;
+	}
 
 	void PixelGameEngine::olc_UpdateMouseFocus(bool state)
 	{ bHasMouseFocus = state; }
@@ -3106,8 +3415,27 @@ namespace olc
 
 		while (bAtomActive)
 		{
-			// Run as fast as possible
-			while (bAtomActive) { olc_CoreUpdate(); }
+			if (bRenderThread)
+			{
+				// This thread keeps the graphics context and renders, a second one runs the game
+				bUpdateFinished = false;
+				std::thread update = std::thread(&PixelGameEngine::olc_UpdateThread, this);
+				olc_RenderThread();
+				update.join();
+
+				// Frames left over from this run must not be drawn after a restart
+				vFramePending.clear();
+				vFrameDrawn.clear();
+				bFramePending = false;
+			}
+			else
+			{
+				// Run as fast as possible
+				while (bAtomActive) { olc_CoreUpdate(); }
+			}
+
+			// Frames still queued are handed over before the user can close whatever receives them
+			olc_FlushFrameReads();
 
 			// Allow the user to free resources if they have overrided the destroy function
 			if (!OnUserDestroy())
@@ -3123,6 +3451,7 @@ namespace olc
 	void PixelGameEngine::olc_PrepareEngine()
 	{
 		// Start OpenGL, the context is owned by the game thread
+		if (nRendererThreads >= 0) renderer->SetThreads(nRendererThreads);
 		if (platform->CreateGraphics(bFullScreen, bEnableVSYNC, vViewPos, vViewSize) == olc::FAIL) return;
 
 		// Construct default font sheet
@@ -3140,6 +3469,13 @@ namespace olc
 
 
 	void PixelGameEngine::olc_CoreUpdate()
+	{
+		float fElapsedTime = olc_UpdateFrame();
+		olc_CaptureFrame(vFrameDrawn, false);
+		olc_RenderFrame(vFrameDrawn, fElapsedTime);
+	}
+
+	float PixelGameEngine::olc_UpdateFrame()
 	{
 		// Handle Timing
 		m_tp2 = std::chrono::system_clock::now();
@@ -3147,11 +3483,19 @@ namespace olc
 		m_tp1 = m_tp2;
 
 		// Our time per frame coefficient
+#if defined(OLC_PGE_HEADLESS)
+		// Nothing throttles a headless engine, so simulated time advances by a
+		// fixed amount per frame rather than following the wall clock
+		UNUSED(elapsedTime);
+		float fElapsedTime = fHeadlessElapsed;
+#else
 		float fElapsedTime = elapsedTime.count();
+#endif
 		fLastElapsed = fElapsedTime;
 
-		// Some platforms will need to check for events
-		platform->HandleSystemEvent();
+		// Some platforms will need to check for events. With a render thread, that thread does
+		// it, as it owns the window's graphics context
+		if (!bRenderThread) platform->HandleSystemEvent();
 
 		// Compare hardware input states from previous frame
 		auto ScanHardware = [&](HWButton* pKeys, bool* pStateOld, bool* pStateNew, uint32_t nKeyCount)
@@ -3177,15 +3521,17 @@ namespace olc
 			}
 		};
 
-		ScanHardware(pKeyboardState, pKeyOldState, pKeyNewState, 256);
-		ScanHardware(pMouseState, pMouseOldState, pMouseNewState, nMouseButtons);
-
-		// Cache mouse coordinates so they remain consistent during frame
-		vMousePos = vMousePosCache;
-		nMouseWheelDelta = nMouseWheelDeltaCache;
-		nMouseWheelDeltaCache = 0;
+		{
+			std::lock_guard<std::mutex> lock(muxInput);
+			ScanHardware(pKeyboardState, pKeyOldState, pKeyNewState, 256);
+			ScanHardware(pMouseState, pMouseOldState, pMouseNewState, nMouseButtons);
 
-		//	renderer->ClearBuffer(olc::BLACK, true);
+			// Cache mouse coordinates so they remain consistent during frame
+			vMousePos = vMousePosCache;
+			vMouseWindowPos = vMouseWindowPosCache;
+			nMouseWheelDelta = nMouseWheelDeltaCache;
+			nMouseWheelDeltaCache = 0;
+		}
 
 		// Handle Frame Update
 		bool bExtensionBlockFrame = false;
@@ -3195,27 +3541,75 @@ namespace olc
 			if (!OnUserUpdate(fElapsedTime)) bAtomActive = false;
 		}
 		for (auto& ext : vExtensions) ext->OnAfterUserUpdate(fElapsedTime);
+		return fElapsedTime;
+	}
 
-		// Display Frame
-		renderer->UpdateViewport(vViewPos, vViewSize);
-		renderer->ClearBuffer(olc::BLACK, true);
-
+	void PixelGameEngine::olc_CaptureFrame(std::vector<LayerFrame>& frame, bool bCopyPixels)
+	{
 		// Layer 0 must always exist
 		vLayers[0].bUpdate = true;
 		vLayers[0].bShow = true;
 		SetDecalMode(DecalMode::NORMAL);
+
+		frame.resize(vLayers.size());
+		for (size_t i = 0; i < vLayers.size(); i++)
+		{
+			LayerDesc& layer = vLayers[i];
+			LayerFrame& out = frame[i];
+			out.bShow = layer.bShow;
+			out.bUpdate = layer.bShow && layer.bUpdate;
+			out.nTexture = layer.pDrawTarget.Decal()->id;
+			out.pSprite = layer.pDrawTarget.Sprite();
+			out.vOffset = layer.vOffset;
+			out.vScale = layer.vScale;
+			out.tint = layer.tint;
+			out.funcHook = layer.funcHook;
+			if (out.bUpdate)
+			{
+				// Only rows drawn to since the last upload are sent, and a layer nothing
+				// has drawn to is not uploaded at all
+				layer.bUpdate = false;
+				out.bUpdate = out.pSprite->IsDirty();
+				out.nUpdateTop = out.pSprite->nDirtyTop;
+				out.nUpdateBottom = out.pSprite->nDirtyBottom;
+				out.pSprite->MarkClean();
+				if (out.bUpdate && bCopyPixels)
+				{
+					// The game draws the next frame into the layer while this one is uploaded
+					if (!out.pCopy || out.pCopy->width != out.pSprite->width || out.pCopy->height != out.pSprite->height)
+						out.pCopy = std::make_unique<olc::Sprite>(out.pSprite->width, out.pSprite->height);
+					size_t nOffset = size_t(out.nUpdateTop) * out.pSprite->width;
+					std::memcpy(out.pCopy->GetData() + nOffset, out.pSprite->GetData() + nOffset,
+						sizeof(olc::Pixel) * out.pSprite->width * (out.nUpdateBottom - out.nUpdateTop));
+					out.pSprite = out.pCopy.get();
+				}
+			}
+
+			// Hand the decals over and take back the cleared lists of an earlier frame
+			out.vecDecalInstance.clear();
+			out.decalArena.clear();
+			std::swap(out.vecDecalInstance, layer.vecDecalInstance);
+			std::swap(out.decalArena, layer.decalArena);
+		}
+	}
+
+	void PixelGameEngine::olc_RenderFrame(std::vector<LayerFrame>& frame, float fElapsedTime)
+	{
+		// Display Frame
+		renderer->UpdateViewport(vViewPos, vViewSize);
+		renderer->ClearBuffer(olc::BLACK, true);
 		renderer->PrepareDrawing();
 
-		for (auto layer = vLayers.rbegin(); layer != vLayers.rend(); ++layer)
+		for (auto layer = frame.rbegin(); layer != frame.rend(); ++layer)
 		{
 			if (layer->bShow)
 			{
 				if (layer->funcHook == nullptr)
 				{
-					renderer->ApplyTexture(layer->pDrawTarget.Decal()->id);
+					renderer->ApplyTexture(layer->nTexture);
 					if (layer->bUpdate)
 					{
-						layer->pDrawTarget.Decal()->Update();
+						renderer->UpdateTextureRows(layer->nTexture, layer->pSprite, layer->nUpdateTop, layer->nUpdateBottom);
 						layer->bUpdate = false;
 					}
 
@@ -3223,8 +3617,8 @@ namespace olc
 
 					// Display Decals in order for this layer
 					for (auto& decal : layer->vecDecalInstance)
-						renderer->DrawDecal(decal);
-					layer->vecDecalInstance.clear();
+						layer->decalArena.Bind(decal);
+					renderer->DrawDecals(layer->vecDecalInstance.data(), layer->vecDecalInstance.size());
 				}
 				else
 				{
@@ -3234,6 +3628,8 @@ namespace olc
 			}
 		}
 
+		if (funcFrameReader) olc_ReadFrame();
+
 		// Present Graphics to screen
 		renderer->DisplayFrame();
 
@@ -3250,22 +3646,83 @@ namespace olc
 		}
 	}
 
-	void PixelGameEngine::olc_ConstructFontSheet()
+	void PixelGameEngine::olc_UpdateThread()
 	{
-		std::string data;
-		data += "?Q`0001oOch0o01o@F40o0<AGD4090LAGD<090@A7ch0?00O7Q`0600>00000000";
-		data += "O000000nOT0063Qo4d8>?7a14Gno94AA4gno94AaOT0>o3`oO400o7QN00000400";
-		data += "Of80001oOg<7O7moBGT7O7lABET024@aBEd714AiOdl717a_=TH013Q>00000000";
-		data += "720D000V?V5oB3Q_HdUoE7a9@DdDE4A9@DmoE4A;Hg]oM4Aj8S4D84@`00000000";
-		data += "OaPT1000Oa`^13P1@AI[?g`1@A=[OdAoHgljA4Ao?WlBA7l1710007l100000000";
-		data += "ObM6000oOfMV?3QoBDD`O7a0BDDH@5A0BDD<@5A0BGeVO5ao@CQR?5Po00000000";
-		data += "Oc``000?Ogij70PO2D]??0Ph2DUM@7i`2DTg@7lh2GUj?0TO0C1870T?00000000";
-		data += "70<4001o?P<7?1QoHg43O;`h@GT0@:@LB@d0>:@hN@L0@?aoN@<0O7ao0000?000";
-		data += "OcH0001SOglLA7mg24TnK7ln24US>0PL24U140PnOgl0>7QgOcH0K71S0000A000";
-		data += "00H00000@Dm1S007@DUSg00?OdTnH7YhOfTL<7Yh@Cl0700?@Ah0300700000000";
-		data += "<008001QL00ZA41a@6HnI<1i@FHLM81M@@0LG81?O`0nC?Y7?`0ZA7Y300080000";
-		data += "O`082000Oh0827mo6>Hn?Wmo?6HnMb11MP08@C11H`08@FP0@@0004@000000000";
-		data += "00P00001Oab00003OcKP0006@6=PMgl<@440MglH@000000`@000001P00000000";
+		while (bAtomActive)
+		{
+			float fElapsedTime = olc_UpdateFrame();
+
+			// Wait for the render thread to take the previous frame, then hand this one over. The
+			// render thread only stops once this thread has finished and nothing is pending
+			std::unique_lock<std::mutex> lock(muxFrame);
+			cvFrame.wait(lock, [&] { return !bFramePending; });
+			olc_CaptureFrame(vFramePending, true);
+			fFramePendingElapsed = fElapsedTime;
+			bFramePending = true;
+			cvFrame.notify_all();
+		}
+
+		std::lock_guard<std::mutex> lock(muxFrame);
+		bUpdateFinished = true;
+		cvFrame.notify_all();
+	}
+
+	void PixelGameEngine::olc_RenderThread()
+	{
+		while (true)
+		{
+			platform->HandleSystemEvent();
+
+			float fElapsedTime = 0.0f;
+			{
+				std::unique_lock<std::mutex> lock(muxFrame);
+				cvFrame.wait(lock, [&] { return bFramePending || bUpdateFinished; });
+				if (!bFramePending) break;
+				std::swap(vFramePending, vFrameDrawn);
+				fElapsedTime = fFramePendingElapsed;
+				bFramePending = false;
+				cvFrame.notify_all();
+			}
+
+			olc_RenderFrame(vFrameDrawn, fElapsedTime);
+		}
+	}
+
+	void PixelGameEngine::olc_ReadFrame()
+	{
+		// Hand over the frames that have arrived, then queue this one. If the queue is still full,
+		// wait for its oldest frame rather than leave a gap in the sequence
+		while (renderer->EndFrameRead(&sprFrameRead, false)) funcFrameReader(&sprFrameRead);
+		if (renderer->BeginFrameRead()) return;
+		if (renderer->EndFrameRead(&sprFrameRead, true))
+		{
+			funcFrameReader(&sprFrameRead);
+			renderer->BeginFrameRead();
+		}
+	}
+
+	void PixelGameEngine::olc_FlushFrameReads()
+	{
+		while (renderer->EndFrameRead(&sprFrameRead, true))
+			if (funcFrameReader) funcFrameReader(&sprFrameRead);
+	}
+
+	void PixelGameEngine::olc_ConstructFontSheet()
+	{
+		std::string data;
+		data += "?Q`0001oOch0o01o@F40o0<AGD4090LAGD<090@A7ch0?00O7Q`0600>00000000";
+		data += "O000000nOT0063Qo4d8>?7a14Gno94AA4gno94AaOT0>o3`oO400o7QN00000400";
+		data += "Of80001oOg<7O7moBGT7O7lABET024@aBEd714AiOdl717a_=TH013Q>00000000";
+		data += "720D000V?V5oB3Q_HdUoE7a9@DdDE4A9@DmoE4A;Hg]oM4Aj8S4D84@`00000000";
+		data += "OaPT1000Oa`^13P1@AI[?g`1@A=[OdAoHgljA4Ao?WlBA7l1710007l100000000";
+		data += "ObM6000oOfMV?3QoBDD`O7a0BDDH@5A0BDD<@5A0BGeVO5ao@CQR?5Po00000000";
+		data += "Oc``000?Ogij70PO2D]??0Ph2DUM@7i`2DTg@7lh2GUj?0TO0C1870T?00000000";
+		data += "70<4001o?P<7?1QoHg43O;`h@GT0@:@LB@d0>:@hN@L0@?aoN@<0O7ao0000?000";
+		data += "OcH0001SOglLA7mg24TnK7ln24US>0PL24U140PnOgl0>7QgOcH0K71S0000A000";
+		data += "00H00000@Dm1S007@DUSg00?OdTnH7YhOfTL<7Yh@Cl0700?@Ah0300700000000";
+		data += "<008001QL00ZA41a@6HnI<1i@FHLM81M@@0LG81?O`0nC?Y7?`0ZA7Y300080000";
+		data += "O`082000Oh0827mo6>Hn?Wmo?6HnMb11MP08@C11H`08@FP0@@0004@000000000";
+		data += "00P00001Oab00003OcKP0006@6=PMgl<@440MglH@000000`@000001P00000000";
 		data += "Ob@8@@00Ob@8@Ga13R@8Mga172@8?PAo3R@827QoOb@820@0O`0007`0000007P0";
 		data += "O`000P08Od400g`<3V=P0G`673IP0`@3>1`00P@6O`P00g`<O`000GP800000000";
 		data += "?P9PL020O`<`N3R0@E4HC7b0@ET<ATB0@@l6C4B0O`H3N7b0?P01L3R000000020";
@@ -3300,6 +3757,37 @@ namespace olc
 
 		for (auto c : vSpacing) vFontSpacing.push_back({ c >> 4, c & 15 });
 
+		vGlyphRuns.clear();
+		for (int32_t g = 0; g < 96; g++)
+		{
+			nGlyphRunStart[g] = uint16_t(vGlyphRuns.size());
+			int32_t ox = (g % 16) * 8, oy = (g / 16) * 8;
+			for (int32_t j = 0; j < 8; j++)
+			{
+				int32_t i = 0;
+				while (i < 8)
+				{
+					if (fontSprite->GetPixel(ox + i, oy + j).r == 0) { i++; continue; }
+					int32_t i0 = i;
+					while (i < 8 && fontSprite->GetPixel(ox + i, oy + j).r > 0) i++;
+					vGlyphRuns.push_back({ uint8_t(j), uint8_t(i0), uint8_t(i) });
+				}
+			}
+		}
+		nGlyphRunStart[96] = uint16_t(vGlyphRuns.size());
+	}
+
+	void PixelGameEngine::olc_DrawGlyph(int32_t x, int32_t y, int32_t g, int32_t c0, int32_t c1, Pixel col, uint32_t scale)
+	{
+		if (g < 0 || g >= 96) return;
+		int32_t s = int32_t(std::max(scale, 1u));
+		for (uint16_t r = nGlyphRunStart[g]; r < nGlyphRunStart[g + 1]; r++)
+		{
+			const GlyphRun& run = vGlyphRuns[r];
+			int32_t x0 = std::max(int32_t(run.x0), c0);
+			int32_t x1 = std::min(int32_t(run.x1), c1);
+			if (x0 < x1) FillRect(x + (x0 - c0) * s, y + run.row * s, (x1 - x0) * s, s, col);
+		}
 	}
 
 	void PixelGameEngine::pgex_Register(olc::PGEX* pgex)
@@ -3392,6 +3880,39 @@ namespace olc
 		X11::XVisualInfo* olc_VisualInfo = nullptr;
 #endif
 
+		// Client side vertex arrays (GL 1.1) replace glBegin/glEnd, so a whole run of decals costs
+		// one glDrawArrays instead of three calls per vertex. The texture coordinate carries "w" as
+		// its q component, as glTexCoord4f did, to keep warped decals perspective correct
+		struct locVertex
+		{
+			float pos[2];
+			float tex[4];
+			olc::Pixel col;
+		};
+
+		std::vector<locVertex> vBatchVerts;
+		std::vector<uint32_t> vBatchFirst;
+
+		// GL 1.0 has no pixel buffers, so a frame read copies the viewport straight away and only
+		// one can be queued at a time
+		olc::vi2d vViewportPos = { 0, 0 };
+		olc::vi2d vViewportSize = { 0, 0 };
+		olc::vi2d vReadSize = { 0, 0 };
+		std::vector<olc::Pixel> vReadPixels;
+		bool bReadQueued = false;
+
+		void SetVertexPointers(const locVertex* verts)
+		{
+			glVertexPointer(2, GL_FLOAT, sizeof(locVertex), verts->pos);
+			glTexCoordPointer(4, GL_FLOAT, sizeof(locVertex), verts->tex);
+			glColorPointer(4, GL_UNSIGNED_BYTE, sizeof(locVertex), &verts->col);
+		}
+
+		static uint32_t DecalTexture(const olc::DecalInstance& decal)
+		{
+			return decal.decal == nullptr ? 0 : decal.decal->id;
+		}
+
 	public:
 		void PrepareDevice() override
 		{
@@ -3523,6 +4044,9 @@ namespace olc
 			nDecalMode = DecalMode::NORMAL;
 			nDecalStructure = DecalStructure::FAN;
 			glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+			glEnableClientState(GL_VERTEX_ARRAY);
+			glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+			glEnableClientState(GL_COLOR_ARRAY);
 		}
 
 		void SetDecalMode(const olc::DecalMode& mode)
@@ -3558,17 +4082,44 @@ namespace olc
 
 		void DrawLayerQuad(const olc::vf2d& offset, const olc::vf2d& scale, const olc::Pixel tint) override
 		{
-			glBegin(GL_QUADS);
-			glColor4ub(tint.r, tint.g, tint.b, tint.a);
-			glTexCoord2f(0.0f * scale.x + offset.x, 1.0f * scale.y + offset.y);
-			glVertex3f(-1.0f /*+ vSubPixelOffset.x*/, -1.0f /*+ vSubPixelOffset.y*/, 0.0f);
-			glTexCoord2f(0.0f * scale.x + offset.x, 0.0f * scale.y + offset.y);
-			glVertex3f(-1.0f /*+ vSubPixelOffset.x*/, 1.0f /*+ vSubPixelOffset.y*/, 0.0f);
-			glTexCoord2f(1.0f * scale.x + offset.x, 0.0f * scale.y + offset.y);
-			glVertex3f(1.0f /*+ vSubPixelOffset.x*/, 1.0f /*+ vSubPixelOffset.y*/, 0.0f);
-			glTexCoord2f(1.0f * scale.x + offset.x, 1.0f * scale.y + offset.y);
-			glVertex3f(1.0f /*+ vSubPixelOffset.x*/, -1.0f /*+ vSubPixelOffset.y*/, 0.0f);
-			glEnd();
+			locVertex verts[4] = {
+				{ { -1.0f, -1.0f }, { 0.0f * scale.x + offset.x, 1.0f * scale.y + offset.y, 0.0f, 1.0f }, tint },
+				{ { -1.0f, +1.0f }, { 0.0f * scale.x + offset.x, 0.0f * scale.y + offset.y, 0.0f, 1.0f }, tint },
+				{ { +1.0f, +1.0f }, { 1.0f * scale.x + offset.x, 0.0f * scale.y + offset.y, 0.0f, 1.0f }, tint },
+				{ { +1.0f, -1.0f }, { 1.0f * scale.x + offset.x, 1.0f * scale.y + offset.y, 0.0f, 1.0f }, tint },
+			};
+			SetVertexPointers(verts);
+			glDrawArrays(GL_TRIANGLE_FAN, 0, 4);
+		}
+
+		void DrawDecals(const olc::DecalInstance* decals, size_t count) override
+		{
+			vBatchVerts.clear();
+			vBatchFirst.clear();
+			for (size_t i = 0; i < count; i++)
+			{
+				const olc::DecalInstance& decal = decals[i];
+				vBatchFirst.push_back(uint32_t(vBatchVerts.size()));
+				if (decal.mode == olc::DecalMode::MODEL3D) continue;
+				ForEachBatchedVertex(decal, [&](uint32_t n) {
+					vBatchVerts.push_back({ { decal.pos[n].x, decal.pos[n].y }, { decal.uv[n].x, decal.uv[n].y, 0.0f, decal.w[n] }, decal.tint[n] });
+				});
+			}
+			vBatchFirst.push_back(uint32_t(vBatchVerts.size()));
+			if (!vBatchVerts.empty()) SetVertexPointers(vBatchVerts.data());
+
+			// One draw call per run of decals sharing a texture and blend mode
+			ForEachDecalRun(decals, count, DecalTexture, [&](size_t first, size_t last) {
+				SetDecalMode(decals[first].mode);
+				if (nDecalMode == DecalMode::MODEL3D)
+				{
+					for (size_t i = first; i < last; i++) DrawDecal(decals[i]);
+					if (!vBatchVerts.empty()) SetVertexPointers(vBatchVerts.data());
+					return;
+				}
+				glBindTexture(GL_TEXTURE_2D, DecalTexture(decals[first]));
+				glDrawArrays(nDecalMode == DecalMode::WIREFRAME ? GL_LINE_LOOP : GL_TRIANGLES, vBatchFirst[first], vBatchFirst[last] - vBatchFirst[first]);
+			});
 		}
 
 		void DrawDecal(const olc::DecalInstance& decal) override
@@ -3621,27 +4172,8 @@ namespace olc
 			}
 			else
 			{
-				if (nDecalMode == DecalMode::WIREFRAME)
-					glBegin(GL_LINE_LOOP);
-				else
-				{
-					if(decal.structure == olc::DecalStructure::FAN)
-						glBegin(GL_TRIANGLE_FAN);
-					else if(decal.structure == olc::DecalStructure::STRIP)
-						glBegin(GL_TRIANGLE_STRIP);
-					else if(decal.structure == olc::DecalStructure::LIST)
-						glBegin(GL_TRIANGLES);
-				}
-
 				// Render as 2D Spatial entity
-				for (uint32_t n = 0; n < decal.points; n++)
-				{
-					glColor4ub(decal.tint[n].r, decal.tint[n].g, decal.tint[n].b, decal.tint[n].a);
-					glTexCoord4f(decal.uv[n].x, decal.uv[n].y, 0.0f, decal.w[n]);
-					glVertex2f(decal.pos[n].x, decal.pos[n].y);
-				}
-
-				glEnd();
+				DrawDecals(&decal, 1);
 			}
 			
 
@@ -3693,11 +4225,48 @@ namespace olc
 			glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, spr->width, spr->height, 0, GL_RGBA, GL_UNSIGNED_BYTE, spr->GetData());
 		}
 
+		void UpdateTextureRows(uint32_t id, olc::Sprite* spr, int32_t y0, int32_t y1) override
+		{
+			UNUSED(id);
+			// Whole rows are contiguous in the sprite, so no unpack row length is needed
+			glTexSubImage2D(GL_TEXTURE_2D, 0, 0, y0, spr->width, y1 - y0, GL_RGBA, GL_UNSIGNED_BYTE, spr->GetData() + size_t(y0) * spr->width);
+		}
+
 		void ReadTexture(uint32_t id, olc::Sprite* spr) override
 		{
 			glReadPixels(0, 0, spr->width, spr->height, GL_RGBA, GL_UNSIGNED_BYTE, spr->GetData());
 		}
 
+		bool BeginFrameRead() override
+		{
+			if (bReadQueued || vViewportSize.x <= 0 || vViewportSize.y <= 0) return false;
+			vReadSize = vViewportSize;
+			vReadPixels.resize(size_t(vReadSize.x) * size_t(vReadSize.y));
+			glReadPixels(vViewportPos.x, vViewportPos.y, vReadSize.x, vReadSize.y, GL_RGBA, GL_UNSIGNED_BYTE, vReadPixels.data());
+			bReadQueued = true;
+			return true;
+		}
+
+		bool EndFrameRead(olc::Sprite* spr, bool bWait) override
+		{
+			// The frame was copied when it was queued, so there is never anything to wait for
+			UNUSED(bWait);
+			if (!bReadQueued) return false;
+			bReadQueued = false;
+
+			if (spr->width != vReadSize.x || spr->height != vReadSize.y)
+			{
+				spr->width = vReadSize.x;
+				spr->height = vReadSize.y;
+				spr->pColData.resize(size_t(spr->width) * size_t(spr->height));
+			}
+			// OpenGL stores the bottom row first
+			for (int32_t y = 0; y < spr->height; y++)
+				std::memcpy(spr->GetData() + size_t(y) * spr->width, vReadPixels.data() + size_t(spr->height - 1 - y) * spr->width, sizeof(olc::Pixel) * spr->width);
+			spr->MarkDirty();
+			return true;
+		}
+
 		void ApplyTexture(uint32_t id) override
 		{
 			glBindTexture(GL_TEXTURE_2D, id);
@@ -3713,6 +4282,8 @@ namespace olc
 		void UpdateViewport(const olc::vi2d& pos, const olc::vi2d& size) override
 		{
 			glViewport(pos.x, pos.y, size.x, size.y);
+			vViewportPos = pos;
+			vViewportSize = size;
 		}
 	};
 }
@@ -3801,8 +4372,17 @@ namespace olc
 	typedef void CALLSTYLE locBindVertexArray_t(GLuint array);
 	typedef void CALLSTYLE locGenVertexArrays_t(GLsizei n, GLuint* arrays);
 	typedef void CALLSTYLE locGetShaderInfoLog_t(GLuint shader, GLsizei bufSize, GLsizei* length, GLchar* infoLog);
+	typedef void CALLSTYLE locDrawArraysInstanced_t(GLenum mode, GLint first, GLsizei count, GLsizei instancecount);
+	typedef void CALLSTYLE locVertexAttribDivisor_t(GLuint index, GLuint divisor);
+	typedef struct locSync_s* locSync;
+	typedef void* CALLSTYLE locMapBufferRange_t(GLenum target, ptrdiff_t offset, GLsizeiptr length, GLbitfield access);
+	typedef GLboolean CALLSTYLE locUnmapBuffer_t(GLenum target);
+	typedef locSync CALLSTYLE locFenceSync_t(GLenum condition, GLbitfield flags);
+	typedef GLenum CALLSTYLE locClientWaitSync_t(locSync sync, GLbitfield flags, uint64_t timeout);
+	typedef void CALLSTYLE locDeleteSync_t(locSync sync);
 
 	constexpr size_t OLC_MAX_VERTS = 128;
+	constexpr size_t OLC_PIXEL_BUFFERS = 4; // Uploads or read backs that can be in flight at once
 
 	class Renderer_OGL33 : public olc::Renderer
 	{
@@ -3849,6 +4429,13 @@ namespace olc
 		locGenVertexArrays_t* locGenVertexArrays = nullptr;
 		locSwapInterval_t* locSwapInterval = nullptr;
 		locGetShaderInfoLog_t* locGetShaderInfoLog = nullptr;
+		locDrawArraysInstanced_t* locDrawArraysInstanced = nullptr;
+		locVertexAttribDivisor_t* locVertexAttribDivisor = nullptr;
+		locMapBufferRange_t* locMapBufferRange = nullptr;
+		locUnmapBuffer_t* locUnmapBuffer = nullptr;
+		locFenceSync_t* locFenceSync = nullptr;
+		locClientWaitSync_t* locClientWaitSync = nullptr;
+		locDeleteSync_t* locDeleteSync = nullptr;
 
 		uint32_t m_nFS = 0;
 		uint32_t m_nVS = 0;
@@ -3856,6 +4443,26 @@ namespace olc
 		uint32_t m_vbQuad = 0;
 		uint32_t m_vaQuad = 0;
 
+		// Axis aligned quads with one tint, which is nearly every sprite, are drawn instanced: each
+		// is a single locInstance and the vertex shader expands it into a 4 vertex strip. Without
+		// instanced drawing (OpenGL ES 2.0) they take the triangle path like every other decal
+		bool bInstancing = false;
+		uint32_t m_nInstanceVS = 0;
+		uint32_t m_nInstanceShader = 0;
+		uint32_t m_vbInstance = 0;
+		uint32_t m_vaInstance = 0;
+		uint32_t m_nProgram = 0;
+
+		struct locInstance
+		{
+			float rect[4]; // Top left and bottom right corners, in clip space
+			float uv[4]; // Texture coordinates of the same corners
+			olc::Pixel col;
+		};
+
+		std::vector<locInstance> vInstances;
+		std::vector<uint32_t> vInstanceFirst;
+
 		struct locVertex
 		{
 			float pos[3];
@@ -3863,10 +4470,98 @@ namespace olc
 			olc::Pixel col;
 		};
 
-		locVertex pVertexMem[OLC_MAX_VERTS];
+		// Vertices of every decal in the layer being drawn, expanded to triangles (or line loops for
+		// wireframes), and where each decal's vertices start. Both keep their capacity between frames.
+		std::vector<locVertex> vBatchVerts;
+		std::vector<uint32_t> vBatchFirst;
 
 		olc::Renderable rendBlankQuad;
 
+		// Texture uploads and frame read backs go through rings of pixel buffer objects, so the
+		// copy between buffer and texture or framebuffer happens on the GPU's time. A fence per
+		// buffer says when the GPU is done with it
+		struct locPixelBuffer
+		{
+			uint32_t id = 0;
+			size_t size = 0;
+			locSync fence = nullptr;
+			olc::vi2d vSize; // Size of the frame a read back holds
+		};
+
+		bool bPixelBuffers = false;
+		locPixelBuffer pUploads[OLC_PIXEL_BUFFERS];
+		locPixelBuffer pReads[OLC_PIXEL_BUFFERS];
+		size_t nNextUpload = 0;
+		size_t nFirstRead = 0; // Oldest queued read back
+		size_t nReadCount = 0;
+		olc::vi2d vViewportPos;
+		olc::vi2d vViewportSize;
+
+		// Wait for the GPU to finish with "buf", if it has not already
+		void WaitPixelBuffer(locPixelBuffer& buf)
+		{
+			if (buf.fence == nullptr) return;
+			locClientWaitSync(buf.fence, 0x00000001, ~uint64_t(0));
+			locDeleteSync(buf.fence);
+			buf.fence = nullptr;
+		}
+
+		// Copy rows [y0, y1) of "spr" into the next upload buffer and leave it bound, so the
+		// texture call that follows sources it and returns without waiting for the transfer
+		void StageUpload(olc::Sprite* spr, int32_t y0, int32_t y1)
+		{
+			locPixelBuffer& buf = pUploads[nNextUpload];
+			nNextUpload = (nNextUpload + 1) % OLC_PIXEL_BUFFERS;
+			WaitPixelBuffer(buf);
+
+			size_t nBytes = sizeof(olc::Pixel) * size_t(spr->width) * size_t(y1 - y0);
+			locBindBuffer(0x88EC, buf.id);
+			if (buf.size < nBytes)
+			{
+				locBufferData(0x88EC, nBytes, nullptr, 0x88E0);
+				buf.size = nBytes;
+			}
+			// Unsynchronised is safe, the fence above says the GPU has finished reading
+			void* pDst = locMapBufferRange(0x88EC, 0, nBytes, 0x0002 | 0x0004 | 0x0020);
+			std::memcpy(pDst, spr->GetData() + size_t(y0) * spr->width, nBytes);
+			locUnmapBuffer(0x88EC);
+		}
+
+		// Fence the upload just issued from the buffer StageUpload() picked, and unbind it
+		void FinishUpload()
+		{
+			locPixelBuffer& buf = pUploads[(nNextUpload + OLC_PIXEL_BUFFERS - 1) % OLC_PIXEL_BUFFERS];
+			buf.fence = locFenceSync(0x9117, 0);
+			locBindBuffer(0x88EC, 0);
+		}
+
+		uint32_t DecalTexture(const olc::DecalInstance& decal) const
+		{
+			return decal.decal == nullptr ? rendBlankQuad.Decal()->id : decal.decal->id;
+		}
+
+		// Whether "decal" is a quad the instanced path draws exactly as the vertex path would
+		bool IsSpriteQuad(const olc::DecalInstance& decal) const
+		{
+			if (!bInstancing || decal.points != 4 || decal.structure != olc::DecalStructure::FAN || decal.mode == olc::DecalMode::WIREFRAME) return false;
+			const olc::vf2d* p = decal.pos;
+			const olc::vf2d* t = decal.uv;
+			return p[0].x == p[1].x && p[2].x == p[3].x && p[0].y == p[3].y && p[1].y == p[2].y
+				&& t[0].x == t[1].x && t[2].x == t[3].x && t[0].y == t[3].y && t[1].y == t[2].y
+				&& decal.w[0] == 1.0f && decal.w[1] == 1.0f && decal.w[2] == 1.0f && decal.w[3] == 1.0f
+				&& decal.tint[0] == decal.tint[1] && decal.tint[0] == decal.tint[2] && decal.tint[0] == decal.tint[3];
+		}
+
+		void UseProgram(uint32_t program, uint32_t vertexArray)
+		{
+			if (program == m_nProgram) return;
+			locUseProgram(program);
+			locBindVertexArray(vertexArray);
+			m_nProgram = program;
+		}
+
+
+
 	public:
 		void PrepareDevice() override
 		{
@@ -3991,8 +4686,15 @@ namespace olc
 			locUseProgram = OGL_LOAD(locUseProgram_t, glUseProgram);
 			locGetShaderInfoLog = OGL_LOAD(locGetShaderInfoLog_t, glGetShaderInfoLog);
 #if !defined(OLC_PLATFORM_EMSCRIPTEN)
+			locDrawArraysInstanced = OGL_LOAD(locDrawArraysInstanced_t, glDrawArraysInstanced);
+			locVertexAttribDivisor = OGL_LOAD(locVertexAttribDivisor_t, glVertexAttribDivisor);
 			locBindVertexArray = OGL_LOAD(locBindVertexArray_t, glBindVertexArray);
 			locGenVertexArrays = OGL_LOAD(locGenVertexArrays_t, glGenVertexArrays);
+			locMapBufferRange = OGL_LOAD(locMapBufferRange_t, glMapBufferRange);
+			locUnmapBuffer = OGL_LOAD(locUnmapBuffer_t, glUnmapBuffer);
+			locFenceSync = OGL_LOAD(locFenceSync_t, glFenceSync);
+			locClientWaitSync = OGL_LOAD(locClientWaitSync_t, glClientWaitSync);
+			locDeleteSync = OGL_LOAD(locDeleteSync_t, glDeleteSync);
 #else
 			locBindVertexArray = glBindVertexArrayOES;
 			locGenVertexArrays = glGenVertexArraysOES;
@@ -4045,6 +4747,51 @@ namespace olc
 			locBindBuffer(0x8892, 0);
 			locBindVertexArray(0);
 
+			// Load & Compile Instanced Quad Shader - corner (x, y) of the strip is bit 1 and bit 0 of the vertex id
+			bInstancing = locDrawArraysInstanced && locVertexAttribDivisor;
+			if (bInstancing)
+			{
+				m_nInstanceVS = locCreateShader(0x8B31);
+				const GLchar* strInstanceVS =
+#if defined(__arm__) || defined(OLC_PLATFORM_EMSCRIPTEN)
+					"#version 300 es\n"
+					"precision mediump float;"
+#else
+					"#version 330 core\n"
+#endif
+					"layout(location = 0) in vec4 aRect;\n""layout(location = 1) in vec4 aTex;\n"
+					"layout(location = 2) in vec4 aCol;\n""out vec2 oTex;\n""out vec4 oCol;\n"
+					"void main(){ vec2 c = vec2(float(gl_VertexID >> 1), float(gl_VertexID & 1));"
+					" gl_Position = vec4(mix(aRect.xy, aRect.zw, c), 0.0, 1.0); oTex = mix(aTex.xy, aTex.zw, c); oCol = aCol;}";
+				locShaderSource(m_nInstanceVS, 1, &strInstanceVS, NULL);
+				locCompileShader(m_nInstanceVS);
+
+				m_nInstanceShader = locCreateProgram();
+				locAttachShader(m_nInstanceShader, m_nFS);
+				locAttachShader(m_nInstanceShader, m_nInstanceVS);
+				locLinkProgram(m_nInstanceShader);
+
+				locGenBuffers(1, &m_vbInstance);
+				locGenVertexArrays(1, &m_vaInstance);
+				locBindVertexArray(m_vaInstance);
+				locBindBuffer(0x8892, m_vbInstance);
+				for (GLuint i = 0; i < 3; i++)
+				{
+					locEnableVertexAttribArray(i);
+					locVertexAttribDivisor(i, 1);
+				}
+				locBindBuffer(0x8892, 0);
+				locBindVertexArray(0);
+			}
+
+			// Pixel buffers need OpenGL 3.2 fences, without them transfers stay synchronous
+			bPixelBuffers = locMapBufferRange && locUnmapBuffer && locFenceSync && locClientWaitSync && locDeleteSync;
+			if (bPixelBuffers)
+			{
+				for (auto& buf : pUploads) locGenBuffers(1, &buf.id);
+				for (auto& buf : pReads) locGenBuffers(1, &buf.id);
+			}
+
 			// Create blank texture for spriteless decals
 			rendBlankQuad.Create(1, 1);
 			rendBlankQuad.Sprite()->GetData()[0] = olc::WHITE;
@@ -4063,183 +4810,1240 @@ namespace olc
 			glXDestroyContext(olc_Display, glDeviceContext);
 #endif
 
-#if defined(OLC_PLATFORM_GLUT)
-			glutDestroyWindow(glutGetWindow());
+#if defined(OLC_PLATFORM_GLUT)
+			glutDestroyWindow(glutGetWindow());
+#endif
+
+#if defined(OLC_PLATFORM_EMSCRIPTEN)
+			eglMakeCurrent(olc_Display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+			eglDestroyContext(olc_Display, olc_Context);
+			eglDestroySurface(olc_Display, olc_Surface);
+			eglTerminate(olc_Display);
+			olc_Display = EGL_NO_DISPLAY;
+			olc_Surface = EGL_NO_SURFACE;
+			olc_Context = EGL_NO_CONTEXT;
+#endif
+			return olc::rcode::OK;
+		}
+
+		void DisplayFrame() override
+		{
+#if defined(OLC_PLATFORM_WINAPI)
+			SwapBuffers(glDeviceContext);
+			if (bSync) DwmFlush(); // Woooohooooooo!!!! SMOOOOOOOTH!
+#endif	
+
+#if defined(OLC_PLATFORM_X11)
+			X11::glXSwapBuffers(olc_Display, *olc_Window);
+#endif		
+
+#if defined(OLC_PLATFORM_GLUT)
+			glutSwapBuffers();
+#endif
+
+#if defined(OLC_PLATFORM_EMSCRIPTEN)
+			eglSwapBuffers(olc_Display, olc_Surface);
+#endif
+		}
+
+		void PrepareDrawing() override
+		{
+			glEnable(GL_BLEND);
+			nDecalMode = DecalMode::NORMAL;
+			glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+			locUseProgram(m_nQuadShader);
+			locBindVertexArray(m_vaQuad);
+			m_nProgram = m_nQuadShader;
+
+#if defined(OLC_PLATFORM_EMSCRIPTEN)
+			locVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(locVertex), 0); locEnableVertexAttribArray(0);
+			locVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(locVertex), (void*)(3 * sizeof(float))); locEnableVertexAttribArray(1);
+			locVertexAttribPointer(2, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(locVertex), (void*)(5 * sizeof(float)));	locEnableVertexAttribArray(2);
+#endif
+		}
+
+		void SetDecalMode(const olc::DecalMode& mode) override
+		{
+			if (mode != nDecalMode)
+			{
+				switch (mode)
+				{
+				case olc::DecalMode::NORMAL: glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);	break;
+				case olc::DecalMode::ADDITIVE: glBlendFunc(GL_SRC_ALPHA, GL_ONE); break;
+				case olc::DecalMode::MULTIPLICATIVE: glBlendFunc(GL_DST_COLOR, GL_ONE_MINUS_SRC_ALPHA);	break;
+				case olc::DecalMode::STENCIL: glBlendFunc(GL_ZERO, GL_SRC_ALPHA); break;
+				case olc::DecalMode::ILLUMINATE: glBlendFunc(GL_ONE_MINUS_SRC_ALPHA, GL_SRC_ALPHA);	break;
+				case olc::DecalMode::WIREFRAME: glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);	break;
+				}
+
+				nDecalMode = mode;
+			}
+		}
+
+		void DrawLayerQuad(const olc::vf2d& offset, const olc::vf2d& scale, const olc::Pixel tint) override
+		{
+			UseProgram(m_nQuadShader, m_vaQuad);
+			locBindBuffer(0x8892, m_vbQuad);
+			locVertex verts[4] = {
+				{{-1.0f, -1.0f, 1.0}, {0.0f * scale.x + offset.x, 1.0f * scale.y + offset.y}, tint},
+				{{+1.0f, -1.0f, 1.0}, {1.0f * scale.x + offset.x, 1.0f * scale.y + offset.y}, tint},
+				{{-1.0f, +1.0f, 1.0}, {0.0f * scale.x + offset.x, 0.0f * scale.y + offset.y}, tint},
+				{{+1.0f, +1.0f, 1.0}, {1.0f * scale.x + offset.x, 0.0f * scale.y + offset.y}, tint},
+			};
+
+			locBufferData(0x8892, sizeof(locVertex) * 4, verts, 0x88E0);
+			glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+		}
+
+		void DrawDecal(const olc::DecalInstance& decal) override
+		{
+			DrawDecals(&decal, 1);
+		}
+
+		void DrawDecals(const olc::DecalInstance* decals, size_t count) override
+		{
+			if (count == 0) return;
+
+			// Sprite quads become instances, everything else triangles. Each kind goes into one stream
+			// buffer, respecified (orphaned) once per layer so the driver never waits on the previous
+			// frame's draws
+			vBatchVerts.clear();
+			vBatchFirst.clear();
+			vInstances.clear();
+			vInstanceFirst.clear();
+			for (size_t i = 0; i < count; i++)
+			{
+				const olc::DecalInstance& decal = decals[i];
+				vBatchFirst.push_back(uint32_t(vBatchVerts.size()));
+				vInstanceFirst.push_back(uint32_t(vInstances.size()));
+				if (IsSpriteQuad(decal))
+				{
+					vInstances.push_back({ { decal.pos[0].x, decal.pos[0].y, decal.pos[2].x, decal.pos[2].y },
+						{ decal.uv[0].x, decal.uv[0].y, decal.uv[2].x, decal.uv[2].y }, decal.tint[0] });
+					continue;
+				}
+				ForEachBatchedVertex(decal, [&](uint32_t n) {
+					vBatchVerts.push_back({ { decal.pos[n].x, decal.pos[n].y, decal.w[n] }, { decal.uv[n].x, decal.uv[n].y }, decal.tint[n] });
+				});
+			}
+			vBatchFirst.push_back(uint32_t(vBatchVerts.size()));
+			vInstanceFirst.push_back(uint32_t(vInstances.size()));
+
+			if (!vBatchVerts.empty())
+			{
+				locBindBuffer(0x8892, m_vbQuad);
+				locBufferData(0x8892, sizeof(locVertex) * vBatchVerts.size(), vBatchVerts.data(), 0x88E0);
+			}
+			if (!vInstances.empty())
+			{
+				locBindBuffer(0x8892, m_vbInstance);
+				locBufferData(0x8892, sizeof(locInstance) * vInstances.size(), vInstances.data(), 0x88E0);
+			}
+
+			// One draw call per run of decals sharing a texture, blend mode and path
+			auto key = [&](const olc::DecalInstance& decal) { return (uint64_t(DecalTexture(decal)) << 1) | uint64_t(IsSpriteQuad(decal)); };
+			ForEachDecalRun(decals, count, key, [&](size_t first, size_t last) {
+				SetDecalMode(decals[first].mode);
+				glBindTexture(GL_TEXTURE_2D, DecalTexture(decals[first]));
+				if (IsSpriteQuad(decals[first]))
+				{
+					// No base instance before GL 4.2, so point the attributes at the run's first instance
+					UseProgram(m_nInstanceShader, m_vaInstance);
+					locBindBuffer(0x8892, m_vbInstance);
+					const char* base = (const char*)(sizeof(locInstance) * vInstanceFirst[first]);
+					locVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, sizeof(locInstance), base);
+					locVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, sizeof(locInstance), base + 4 * sizeof(float));
+					locVertexAttribPointer(2, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(locInstance), base + 8 * sizeof(float));
+					locDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, vInstanceFirst[last] - vInstanceFirst[first]);
+				}
+				else
+				{
+					UseProgram(m_nQuadShader, m_vaQuad);
+					glDrawArrays(decals[first].mode == olc::DecalMode::WIREFRAME ? GL_LINE_LOOP : GL_TRIANGLES, vBatchFirst[first], vBatchFirst[last] - vBatchFirst[first]);
+				}
+			});
+		}
+
+		uint32_t CreateTexture(const uint32_t width, const uint32_t height, const bool filtered, const bool clamp) override
+		{
+			UNUSED(width);
+			UNUSED(height);
+			uint32_t id = 0;
+			glGenTextures(1, &id);
+			glBindTexture(GL_TEXTURE_2D, id);
+
+			if (filtered)
+			{
+				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+			}
+			else
+			{
+				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+			}
+
+			if (clamp)
+			{
+				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP);
+				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP);
+			}
+			else
+			{
+				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+			}
+#if !defined(OLC_PLATFORM_EMSCRIPTEN)
+			glTexEnvf(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_MODULATE);
+#endif
+			return id;
+		}
+
+		uint32_t DeleteTexture(const uint32_t id) override
+		{
+			glDeleteTextures(1, &id);
+			return id;
+		}
+
+		void UpdateTexture(uint32_t id, olc::Sprite* spr) override
+		{
+			UNUSED(id);
+			if (!bPixelBuffers || spr->width == 0 || spr->height == 0)
+			{
+				glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, spr->width, spr->height, 0, GL_RGBA, GL_UNSIGNED_BYTE, spr->GetData());
+				return;
+			}
+			StageUpload(spr, 0, spr->height);
+			glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, spr->width, spr->height, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+			FinishUpload();
+		}
+
+		void UpdateTextureRows(uint32_t id, olc::Sprite* spr, int32_t y0, int32_t y1) override
+		{
+			UNUSED(id);
+			// Whole rows are contiguous in the sprite, so no unpack row length is needed
+			if (!bPixelBuffers || spr->width == 0 || y1 <= y0)
+			{
+				glTexSubImage2D(GL_TEXTURE_2D, 0, 0, y0, spr->width, y1 - y0, GL_RGBA, GL_UNSIGNED_BYTE, spr->GetData() + size_t(y0) * spr->width);
+				return;
+			}
+			StageUpload(spr, y0, y1);
+			glTexSubImage2D(GL_TEXTURE_2D, 0, 0, y0, spr->width, y1 - y0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+			FinishUpload();
+		}
+
+		void ReadTexture(uint32_t id, olc::Sprite* spr) override
+		{
+			glReadPixels(0, 0, spr->width, spr->height, GL_RGBA, GL_UNSIGNED_BYTE, spr->GetData());
+		}
+
+		bool BeginFrameRead() override
+		{
+			if (!bPixelBuffers || nReadCount == OLC_PIXEL_BUFFERS || vViewportSize.x <= 0 || vViewportSize.y <= 0) return false;
+			locPixelBuffer& buf = pReads[(nFirstRead + nReadCount) % OLC_PIXEL_BUFFERS];
+			nReadCount++;
+
+			buf.vSize = vViewportSize;
+			size_t nBytes = sizeof(olc::Pixel) * size_t(buf.vSize.x) * size_t(buf.vSize.y);
+			locBindBuffer(0x88EB, buf.id);
+			if (buf.size < nBytes)
+			{
+				locBufferData(0x88EB, nBytes, nullptr, 0x88E1);
+				buf.size = nBytes;
+			}
+			glReadPixels(vViewportPos.x, vViewportPos.y, buf.vSize.x, buf.vSize.y, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+			locBindBuffer(0x88EB, 0);
+			buf.fence = locFenceSync(0x9117, 0);
+			return true;
+		}
+
+		bool EndFrameRead(olc::Sprite* spr, bool bWait) override
+		{
+			if (nReadCount == 0) return false;
+			locPixelBuffer& buf = pReads[nFirstRead];
+			if (!bWait && locClientWaitSync(buf.fence, 0x00000001, 0) == 0x911B) return false;
+			WaitPixelBuffer(buf);
+			nFirstRead = (nFirstRead + 1) % OLC_PIXEL_BUFFERS;
+			nReadCount--;
+
+			if (spr->width != buf.vSize.x || spr->height != buf.vSize.y)
+			{
+				spr->width = buf.vSize.x;
+				spr->height = buf.vSize.y;
+				spr->pColData.resize(size_t(spr->width) * size_t(spr->height));
+			}
+			// OpenGL stores the bottom row first
+			size_t nBytes = sizeof(olc::Pixel) * size_t(spr->width) * size_t(spr->height);
+			locBindBuffer(0x88EB, buf.id);
+			const olc::Pixel* pSrc = (const olc::Pixel*)locMapBufferRange(0x88EB, 0, nBytes, 0x0001);
+			for (int32_t y = 0; y < spr->height; y++)
+				std::memcpy(spr->GetData() + size_t(y) * spr->width, pSrc + size_t(spr->height - 1 - y) * spr->width, sizeof(olc::Pixel) * spr->width);
+			locUnmapBuffer(0x88EB);
+			locBindBuffer(0x88EB, 0);
+			spr->MarkDirty();
+			return true;
+		}
+
+		void ApplyTexture(uint32_t id) override
+		{
+			glBindTexture(GL_TEXTURE_2D, id);
+		}
+
+		void ClearBuffer(olc::Pixel p, bool bDepth) override
+		{
+			glClearColor(float(p.r) / 255.0f, float(p.g) / 255.0f, float(p.b) / 255.0f, float(p.a) / 255.0f);
+			glClear(GL_COLOR_BUFFER_BIT);
+			if (bDepth) glClear(GL_DEPTH_BUFFER_BIT);
+		}
+
+		void UpdateViewport(const olc::vi2d& pos, const olc::vi2d& size) override
+		{
+			glViewport(pos.x, pos.y, size.x, size.y);
+			vViewportPos = pos;
+			vViewportSize = size;
+		}
+	};
+}
+#endif
+// O------------------------------------------------------------------------------O
+// | END RENDERER: OpenGL 3.3 (3.0 es) (sh-sh-sh-shaders....)                     |
+// O------------------------------------------------------------------------------O
+#pragma endregion
+
+#endif // Headless
+
+#pragma region renderer_headless
+// O------------------------------------------------------------------------------O
+// | START RENDERER: Headless (draws nothing, counts everything)                  |
+// O------------------------------------------------------------------------------O
+#if defined(OLC_PGE_HEADLESS) && !defined(OLC_GFX_CUSTOM_EX) && !defined(OLC_GFX_SOFTWARE)
+namespace olc
+{
+	// Accepts the full renderer interface but never touches a graphics device, so
+	// an application can run on machines without a display or GL driver. Draw
+	// calls are dropped, and the frame loop is timed so load tests have numbers
+	class Renderer_Headless : public olc::Renderer
+	{
+	private:
+		uint32_t nTextureCount = 0;
+		uint64_t nFrameCount = 0;
+		uint64_t nDecalCount = 0;
+		double   fSimulatedTime = 0.0;
+		std::chrono::time_point<std::chrono::steady_clock> tpStart;
+
+	public:
+		void PrepareDevice() override
+		{}
+
+		olc::rcode CreateDevice(std::vector<void*> params, bool bFullScreen, bool bVSYNC) override
+		{
+			UNUSED(params);
+			UNUSED(bFullScreen);
+			UNUSED(bVSYNC);
+			nFrameCount = 0;
+			nDecalCount = 0;
+			fSimulatedTime = 0.0;
+			tpStart = std::chrono::steady_clock::now();
+			return olc::rcode::OK;
+		}
+
+		olc::rcode DestroyDevice() override
+		{
+			double fWall = GetWallTime();
+			printf("Headless: %llu frames, %llu decals, %.3fs simulated in %.3fs (%.0f fps, %.1fx real time)\n",
+				(unsigned long long)nFrameCount, (unsigned long long)nDecalCount, fSimulatedTime, fWall,
+				fWall > 0.0 ? double(nFrameCount) / fWall : 0.0, fWall > 0.0 ? fSimulatedTime / fWall : 0.0);
+			return olc::rcode::OK;
+		}
+
+		void DisplayFrame() override
+		{
+			nFrameCount++;
+			fSimulatedTime += ptrPGE->GetElapsedTime();
+		}
+
+		void PrepareDrawing() override
+		{}
+
+		void SetDecalMode(const olc::DecalMode& mode) override
+		{ UNUSED(mode); }
+
+		void DrawLayerQuad(const olc::vf2d& offset, const olc::vf2d& scale, const olc::Pixel tint) override
+		{
+			UNUSED(offset);
+			UNUSED(scale);
+			UNUSED(tint);
+		}
+
+		void DrawDecal(const olc::DecalInstance& decal) override
+		{
+			UNUSED(decal);
+			nDecalCount++;
+		}
+
+		uint32_t CreateTexture(const uint32_t width, const uint32_t height, const bool filtered, const bool clamp) override
+		{
+			UNUSED(width);
+			UNUSED(height);
+			UNUSED(filtered);
+			UNUSED(clamp);
+			return ++nTextureCount;
+		}
+
+		uint32_t DeleteTexture(const uint32_t id) override
+		{ return id; }
+
+		void UpdateTexture(uint32_t id, olc::Sprite* spr) override
+		{
+			UNUSED(id);
+			UNUSED(spr);
+		}
+
+		void ReadTexture(uint32_t id, olc::Sprite* spr) override
+		{
+			UNUSED(id);
+			UNUSED(spr);
+		}
+
+		void ApplyTexture(uint32_t id) override
+		{ UNUSED(id); }
+
+		void ClearBuffer(olc::Pixel p, bool bDepth) override
+		{
+			UNUSED(p);
+			UNUSED(bDepth);
+		}
+
+		void UpdateViewport(const olc::vi2d& pos, const olc::vi2d& size) override
+		{
+			UNUSED(pos);
+			UNUSED(size);
+		}
+
+	public:
+		// Frames presented since the device was created
+		uint64_t GetFrameCount() const
+		{ return nFrameCount; }
+
+		// Decal instances submitted (and dropped) since the device was created
+		uint64_t GetDecalCount() const
+		{ return nDecalCount; }
+
+		// Sum of the elapsed times handed to the application
+		double GetSimulatedTime() const
+		{ return fSimulatedTime; }
+
+		// Real seconds since the device was created
+		double GetWallTime() const
+		{ return std::chrono::duration<double>(std::chrono::steady_clock::now() - tpStart).count(); }
+	};
+}
+#endif
+// O------------------------------------------------------------------------------O
+// | END RENDERER: Headless                                                       |
+// O------------------------------------------------------------------------------O
+#pragma endregion
+
+#pragma region renderer_software
+// O------------------------------------------------------------------------------O
+// | START RENDERER: Software (draws every frame into memory on the CPU)          |
+// O------------------------------------------------------------------------------O
+#if defined(OLC_PGE_HEADLESS) && defined(OLC_GFX_SOFTWARE) && !defined(OLC_GFX_CUSTOM_EX)
+namespace olc
+{
+	// Composites layers and rasterizes decals into a frame held in memory, following the
+	// OpenGL renderers' texture and blending rules, so whole frames can be drawn and checked
+	// on machines without a GPU. Decal triangles are set up once, binned to the screen tiles
+	// they cover, and the tiles are drawn in parallel by a pool of threads
+	class Renderer_Software : public olc::Renderer
+	{
+	private:
+		struct locTexture
+		{
+			int32_t nWidth = 0;
+			int32_t nHeight = 0;
+			bool bFiltered = false;
+			bool bClamp = true;
+			bool bUsed = false;
+			std::vector<olc::Pixel> vPixels;
+		};
+
+		// A decal vertex in frame pixels. Texture coordinates are still multiplied by w
+		struct locVertex
+		{
+			float x, y;
+			float u, v, w;
+			float r, g, b, a;
+		};
+
+		// Interpolated attributes, in the order of locPrimitive::fPlane
+		enum { ATTR_U, ATTR_V, ATTR_W, ATTR_R, ATTR_G, ATTR_B, ATTR_A, ATTR_COUNT };
+
+		// A triangle or wireframe edge, set up once per frame and drawn by every tile it touches
+		struct locPrimitive
+		{
+			const locTexture* tex = nullptr;
+			olc::DecalMode mode = olc::DecalMode::NORMAL;
+			bool bLine = false;
+			bool bFast = false; // Opaque white tint, nearest and clamped, without perspective
+			int32_t nMinX = 0, nMinY = 0, nMaxX = 0, nMaxY = 0; // Pixels that may be drawn, max exclusive
+
+			// Edge functions at the centre of pixel (0, 0), and their steps per pixel in x and y
+			int64_t nEdge[3] = {};
+			int64_t nEdgeX[3] = {};
+			int64_t nEdgeY[3] = {};
+
+			// Attribute planes: value at the first vertex, and change per pixel in x and y
+			float fOriginX = 0.0f, fOriginY = 0.0f;
+			float fPlane[ATTR_COUNT] = {};
+			float fPlaneX[ATTR_COUNT] = {};
+			float fPlaneY[ATTR_COUNT] = {};
+
+			locVertex a = {}, b = {}; // Ends of a line
+		};
+
+		struct locFrameRead
+		{
+			olc::vi2d vSize;
+			std::vector<olc::Pixel> vPixels;
+		};
+
+		static constexpr size_t nFrameReads = 4; // Frames that can be queued by BeginFrameRead()
+		static constexpr int32_t nSubBits = 4;   // Vertices snap to 1/16 of a pixel, so shared edges are tested exactly
+		static constexpr int32_t nSub = 1 << nSubBits;
+		static constexpr int32_t nTileSize = 64; // Decals are drawn in tiles of this many pixels square
+		static constexpr int32_t nJobRows = 16;  // Clears, uploads and layers are split into jobs of this many rows
+
+		std::vector<locTexture> vTextures; // Texture "id" lives at vTextures[id - 1]
+		uint32_t nBoundTexture = 0;
+		std::vector<olc::Pixel> vFrame;
+		olc::vi2d vFrameSize = { 0, 0 };
+		olc::vi2d vTiles = { 0, 0 };
+		std::array<locFrameRead, nFrameReads> vReads;
+		size_t nFirstRead = 0;
+		size_t nReadCount = 0;
+		std::vector<int32_t> vLayerColumns;
+		std::vector<locPrimitive> vPrimitives;
+		std::vector<std::vector<uint32_t>> vTileBins; // Primitives touching each tile, in the order they were drawn
+		std::vector<int32_t> vActiveTiles;
+
+		// Job workers. The calling thread takes jobs too, as thread 0
+		int32_t nThreads = OLC_SOFTWARE_THREADS;
+		std::vector<std::thread> vWorkers;
+		std::vector<std::vector<olc::Pixel>> vThreadRows;
+		std::mutex muxJobs;
+		std::condition_variable cvJobs;
+		std::condition_variable cvJobsDone;
+		std::function<void(int32_t, int32_t)> funcJob;
+		std::atomic<int32_t> nNextJob{ 0 };
+		int32_t nJobCount = 0;
+		uint64_t nJobGeneration = 0;
+		int32_t nJobsPending = 0;
+		bool bQuit = false;
+
+		uint64_t nFrameCount = 0;
+		uint64_t nDecalCount = 0;
+		uint64_t nTriangleCount = 0;
+		double   fSimulatedTime = 0.0;
+		double   fDrawTime = 0.0; // Seconds from each frame's clear to its display, the part split between threads
+		std::chrono::time_point<std::chrono::steady_clock> tpStart;
+		std::chrono::time_point<std::chrono::steady_clock> tpFrameStart;
+
+		void JobWorker(int32_t nThread)
+		{
+			uint64_t nSeen = 0;
+			while (true)
+			{
+				{
+					std::unique_lock<std::mutex> lock(muxJobs);
+					cvJobs.wait(lock, [&] { return bQuit || nJobGeneration != nSeen; });
+					if (bQuit) return;
+					nSeen = nJobGeneration;
+				}
+
+				RunJobs(nThread);
+
+				std::lock_guard<std::mutex> lock(muxJobs);
+				if (--nJobsPending == 0) cvJobsDone.notify_one();
+			}
+		}
+
+		void RunJobs(int32_t nThread)
+		{
+			for (int32_t nJob = nNextJob.fetch_add(1); nJob < nJobCount; nJob = nNextJob.fetch_add(1))
+				funcJob(nJob, nThread);
+		}
+
+		// Calls "func" with the index of each of "nJobs" jobs and of the thread running it, and
+		// returns once all are done. Threads take the next job as they finish one, so jobs of
+		// uneven size still keep every thread busy
+		void ParallelFor(int32_t nJobs, std::function<void(int32_t, int32_t)> func)
+		{
+			if (nJobs <= 0) return;
+			funcJob = std::move(func);
+			nJobCount = nJobs;
+			nNextJob = 0;
+			bool bWake = !vWorkers.empty() && nJobs > 1;
+			if (bWake)
+			{
+				{
+					std::lock_guard<std::mutex> lock(muxJobs);
+					nJobsPending = int32_t(vWorkers.size());
+					nJobGeneration++;
+				}
+				cvJobs.notify_all();
+			}
+
+			RunJobs(0);
+
+			if (bWake)
+			{
+				std::unique_lock<std::mutex> lock(muxJobs);
+				cvJobsDone.wait(lock, [this] { return nJobsPending == 0; });
+			}
+		}
+
+		void StopWorkers()
+		{
+			{
+				std::lock_guard<std::mutex> lock(muxJobs);
+				bQuit = true;
+			}
+			cvJobs.notify_all();
+			for (auto& worker : vWorkers) worker.join();
+			vWorkers.clear();
+			bQuit = false;
+		}
+
+		locTexture* FindTexture(uint32_t id)
+		{
+			if (id == 0 || id > vTextures.size() || !vTextures[id - 1].bUsed) return nullptr;
+			return &vTextures[id - 1];
+		}
+
+		// Texel index "i" along an axis of "n" texels
+		static int32_t WrapTexel(int32_t i, int32_t n, bool bClamp)
+		{
+			if (bClamp) return std::clamp(i, 0, n - 1);
+			i %= n;
+			return i < 0 ? i + n : i;
+		}
+
+		// Texel containing the texture coordinate "f", already scaled by the texture size
+		static int32_t NearestTexel(float f, int32_t n, bool bClamp)
+		{
+			// Also catches NaN, from a decal with a w of zero
+			if (!(f > -1e9f && f < 1e9f)) f = 0.0f;
+			return WrapTexel(int32_t(std::floor(f)), n, bClamp);
+		}
+
+		// Largest integer not above a / b, for b > 0
+		static int64_t FloorDiv(int64_t a, int64_t b)
+		{ return a >= 0 ? a / b : -((b - 1 - a) / b); }
+
+		static uint8_t Div255(uint32_t x)
+		{ return uint8_t(std::min((x + 1 + (x >> 8)) >> 8, 255u)); }
+
+		static olc::Pixel Modulate(olc::Pixel p, uint32_t r, uint32_t g, uint32_t b, uint32_t a)
+		{ return olc::Pixel(Div255(p.r * r), Div255(p.g * g), Div255(p.b * b), Div255(p.a * a)); }
+
+		// Nearest or bilinear lookup, as OpenGL samples a texture. No texture reads as white
+		static olc::Pixel Sample(const locTexture* tex, float u, float v)
+		{
+			if (tex == nullptr) return olc::WHITE;
+			if (tex->vPixels.empty()) return olc::BLANK;
+			const int32_t w = tex->nWidth, h = tex->nHeight;
+			if (!tex->bFiltered)
+				return tex->vPixels[size_t(NearestTexel(v * h, h, tex->bClamp)) * w + NearestTexel(u * w, w, tex->bClamp)];
+
+			float fx = u * w - 0.5f, fy = v * h - 0.5f;
+			if (!(fx > -1e9f && fx < 1e9f)) fx = 0.0f;
+			if (!(fy > -1e9f && fy < 1e9f)) fy = 0.0f;
+			float fx0 = std::floor(fx), fy0 = std::floor(fy);
+			uint32_t nx = uint32_t((fx - fx0) * 256.0f), ny = uint32_t((fy - fy0) * 256.0f);
+			int32_t x0 = WrapTexel(int32_t(fx0), w, tex->bClamp), x1 = WrapTexel(int32_t(fx0) + 1, w, tex->bClamp);
+			int32_t y0 = WrapTexel(int32_t(fy0), h, tex->bClamp), y1 = WrapTexel(int32_t(fy0) + 1, h, tex->bClamp);
+			const olc::Pixel* r0 = tex->vPixels.data() + size_t(y0) * w;
+			const olc::Pixel* r1 = tex->vPixels.data() + size_t(y1) * w;
+			auto Mix = [&](uint8_t p00, uint8_t p10, uint8_t p01, uint8_t p11)
+			{
+				uint32_t t = p00 * (256 - nx) + p10 * nx, b = p01 * (256 - nx) + p11 * nx;
+				return uint8_t((t * (256 - ny) + b * ny + 32768) >> 16);
+			};
+			return olc::Pixel(Mix(r0[x0].r, r0[x1].r, r1[x0].r, r1[x1].r), Mix(r0[x0].g, r0[x1].g, r1[x0].g, r1[x1].g),
+				Mix(r0[x0].b, r0[x1].b, r1[x0].b, r1[x1].b), Mix(r0[x0].a, r0[x1].a, r1[x0].a, r1[x1].a));
+		}
+
+		// The blend function each DecalMode selects in the OpenGL renderers. The frame stays opaque, as it is on screen
+		static olc::Pixel BlendDecal(olc::DecalMode mode, olc::Pixel s, olc::Pixel d)
+		{
+			uint32_t a = s.a, c = 255 - a;
+			switch (mode)
+			{
+			case olc::DecalMode::ADDITIVE:
+				return olc::Pixel(Div255(s.r * a + d.r * 255), Div255(s.g * a + d.g * 255), Div255(s.b * a + d.b * 255));
+			case olc::DecalMode::MULTIPLICATIVE:
+				return olc::Pixel(Div255(d.r * (s.r + c)), Div255(d.g * (s.g + c)), Div255(d.b * (s.b + c)));
+			case olc::DecalMode::STENCIL:
+				return olc::Pixel(Div255(d.r * a), Div255(d.g * a), Div255(d.b * a));
+			case olc::DecalMode::ILLUMINATE:
+				return olc::Pixel(Div255(s.r * c + d.r * a), Div255(s.g * c + d.g * a), Div255(s.b * c + d.b * a));
+			default:
+				return olc::Pixel(Div255(s.r * a + d.r * c), Div255(s.g * a + d.g * c), Div255(s.b * a + d.b * c));
+			}
+		}
+
+		// Blend a row of a layer over the frame. Opaque runs, which blending would only copy, are
+		// copied 8 (AVX2) or 4 (SSE2) pixels at a time
+		static void CompositeRow(olc::Pixel* dst, const olc::Pixel* src, size_t count)
+		{
+			size_t i = 0;
+#if defined(__AVX2__)
+			const __m256i vAlpha8 = _mm256_set1_epi32(int(0xFF000000)), vBlend8 = _mm256_set1_epi16(256);
+			for (; i + 8 <= count; i += 8)
+			{
+				__m256i s = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+				if (_mm256_movemask_epi8(_mm256_cmpeq_epi32(_mm256_and_si256(s, vAlpha8), vAlpha8)) != -1)
+					s = BlendPacked(s, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dst + i)), vBlend8);
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), s);
+			}
+#endif
+#if defined(__AVX__) || defined(__SSE2__) || defined(_M_X64)
+			const __m128i vAlpha4 = _mm_set1_epi32(int(0xFF000000)), vBlend4 = _mm_set1_epi16(256);
+			for (; i + 4 <= count; i += 4)
+			{
+				__m128i s = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+				if (_mm_movemask_epi8(_mm_cmpeq_epi32(_mm_and_si128(s, vAlpha4), vAlpha4)) != 0xFFFF)
+					s = BlendPacked(s, _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i)), vBlend4);
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), s);
+			}
+#endif
+			BlendPixels(dst + i, src + i, count - i, 256);
+		}
+
+		// Shade and blend one pixel of a decal from its interpolated attributes
+		static void ShadePixel(olc::Pixel& dst, const locTexture* tex, olc::DecalMode mode, float u, float v, float w, float r, float g, float b, float a)
+		{
+			float fInvW = 1.0f / w;
+			olc::Pixel s = Modulate(Sample(tex, u * fInvW, v * fInvW),
+				uint32_t(r + 0.5f), uint32_t(g + 0.5f), uint32_t(b + 0.5f), uint32_t(a + 0.5f));
+			dst = BlendDecal(mode, s, dst);
+		}
+
+		locVertex ToFrame(const olc::DecalInstance& decal, uint32_t n) const
+		{
+			const olc::Pixel& t = decal.tint[n];
+			return { (decal.pos[n].x + 1.0f) * 0.5f * float(vFrameSize.x), (1.0f - decal.pos[n].y) * 0.5f * float(vFrameSize.y),
+				decal.uv[n].x, decal.uv[n].y, decal.w[n], float(t.r), float(t.g), float(t.b), float(t.a) };
+		}
+
+		// Add the tiles "prim" may draw to their bins. For triangles, tiles entirely outside one of
+		// the edges are left out
+		void BinPrimitive(const locPrimitive& prim)
+		{
+			uint32_t nIndex = uint32_t(vPrimitives.size() - 1);
+			for (int32_t ty = prim.nMinY / nTileSize; ty <= (prim.nMaxY - 1) / nTileSize; ty++)
+			{
+				for (int32_t tx = prim.nMinX / nTileSize; tx <= (prim.nMaxX - 1) / nTileSize; tx++)
+				{
+					bool bInside = true;
+					for (int k = 0; k < 3 && !prim.bLine && bInside; k++)
+					{
+						// The largest value of the edge function over the tile's pixel centres
+						int64_t x = prim.nEdgeX[k] > 0 ? std::min(tx * nTileSize + nTileSize, vFrameSize.x) - 1 : tx * nTileSize;
+						int64_t y = prim.nEdgeY[k] > 0 ? std::min(ty * nTileSize + nTileSize, vFrameSize.y) - 1 : ty * nTileSize;
+						bInside = prim.nEdge[k] + prim.nEdgeX[k] * x + prim.nEdgeY[k] * y >= 0;
+					}
+					if (bInside) vTileBins[size_t(ty) * vTiles.x + tx].push_back(nIndex);
+				}
+			}
+		}
+
+		void AddTriangle(const locTexture* tex, olc::DecalMode mode, const locVertex* v0, const locVertex* v1, const locVertex* v2)
+		{
+			for (const locVertex* p : { v0, v1, v2 })
+				if (!std::isfinite(p->x) || !std::isfinite(p->y)) return;
+
+			// Vertices far outside the frame are pulled in, which only bends the parts no one sees
+			auto Fix = [](float f) { return int64_t(std::lround(std::clamp(f, -16777216.0f, 16777216.0f) * float(nSub))); };
+			int64_t x0 = Fix(v0->x), y0 = Fix(v0->y), x1 = Fix(v1->x), y1 = Fix(v1->y), x2 = Fix(v2->x), y2 = Fix(v2->y);
+			int64_t nArea = (x1 - x0) * (y2 - y0) - (y1 - y0) * (x2 - x0);
+			if (nArea == 0) return;
+			if (nArea < 0)
+			{
+				std::swap(v1, v2); std::swap(x1, x2); std::swap(y1, y2);
+				nArea = -nArea;
+			}
+
+			locPrimitive prim;
+			prim.nMinX = int32_t(std::max<int64_t>((std::min({ x0, x1, x2 }) - nSub / 2) >> nSubBits, 0));
+			prim.nMaxX = int32_t(std::min<int64_t>(((std::max({ x0, x1, x2 }) - nSub / 2) >> nSubBits) + 1, vFrameSize.x));
+			prim.nMinY = int32_t(std::max<int64_t>((std::min({ y0, y1, y2 }) - nSub / 2) >> nSubBits, 0));
+			prim.nMaxY = int32_t(std::min<int64_t>(((std::max({ y0, y1, y2 }) - nSub / 2) >> nSubBits) + 1, vFrameSize.y));
+			if (prim.nMinX >= prim.nMaxX || prim.nMinY >= prim.nMaxY) return;
+
+			// A centre exactly on an edge belongs to only one of the two triangles sharing it: the
+			// edge keeps it if it runs down, or left along a row
+			auto Edge = [&](int k, int64_t ax, int64_t ay, int64_t bx, int64_t by)
+			{
+				bool bOwn = by > ay || (by == ay && bx < ax);
+				prim.nEdge[k] = (bx - ax) * (nSub / 2 - ay) - (by - ay) * (nSub / 2 - ax) - (bOwn ? 0 : 1);
+				prim.nEdgeX[k] = -(by - ay) * nSub;
+				prim.nEdgeY[k] = (bx - ax) * nSub;
+			};
+			Edge(0, x1, y1, x2, y2);
+			Edge(1, x2, y2, x0, y0);
+			Edge(2, x0, y0, x1, y1);
+
+			// Without perspective, u / w and v / w are planes themselves, and the divide can be
+			// left out. Every attribute is interpolated from the snapped positions
+			const locVertex* v[3] = { v0, v1, v2 };
+			float fAttr[3][ATTR_COUNT];
+			bool bAffine = v0->w == v1->w && v0->w == v2->w && v0->w != 0.0f;
+			for (int i = 0; i < 3; i++)
+			{
+				float fInvW = bAffine ? 1.0f / v[i]->w : 1.0f;
+				float f[ATTR_COUNT] = { v[i]->u * fInvW, v[i]->v * fInvW, bAffine ? 1.0f : v[i]->w, v[i]->r, v[i]->g, v[i]->b, v[i]->a };
+				std::copy(f, f + ATTR_COUNT, fAttr[i]);
+			}
+			double dX1 = double(x1 - x0) / nSub, dY1 = double(y1 - y0) / nSub;
+			double dX2 = double(x2 - x0) / nSub, dY2 = double(y2 - y0) / nSub;
+			double dInvArea = 1.0 / (dX1 * dY2 - dY1 * dX2);
+			prim.fOriginX = float(double(x0) / nSub);
+			prim.fOriginY = float(double(y0) / nSub);
+			for (int k = 0; k < ATTR_COUNT; k++)
+			{
+				double d1 = double(fAttr[1][k]) - fAttr[0][k], d2 = double(fAttr[2][k]) - fAttr[0][k];
+				prim.fPlane[k] = fAttr[0][k];
+				prim.fPlaneX[k] = float((d1 * dY2 - d2 * dY1) * dInvArea);
+				prim.fPlaneY[k] = float((d2 * dX1 - d1 * dX2) * dInvArea);
+			}
+
+			bool bWhite = true;
+			for (int i = 0; i < 3; i++)
+				bWhite &= v[i]->r == 255.0f && v[i]->g == 255.0f && v[i]->b == 255.0f && v[i]->a == 255.0f;
+			prim.tex = tex;
+			prim.mode = mode;
+			prim.bFast = bWhite && bAffine && mode == olc::DecalMode::NORMAL && tex != nullptr && !tex->vPixels.empty()
+				&& !tex->bFiltered && tex->bClamp && int64_t(tex->nWidth) * tex->nHeight < (int64_t(1) << 24);
+
+			vPrimitives.push_back(prim);
+			BinPrimitive(vPrimitives.back());
+		}
+
+		void AddLine(const locTexture* tex, const locVertex& a, const locVertex& b)
+		{
+			if (!std::isfinite(a.x) || !std::isfinite(a.y) || !std::isfinite(b.x) || !std::isfinite(b.y)) return;
+			if (std::max(std::abs(b.x - a.x), std::abs(b.y - a.y)) > 65536.0f) return;
+			locPrimitive prim;
+			prim.tex = tex;
+			prim.mode = olc::DecalMode::WIREFRAME;
+			prim.bLine = true;
+			prim.a = a;
+			prim.b = b;
+			prim.nMinX = std::max(int32_t(std::floor(std::min(a.x, b.x))), 0);
+			prim.nMinY = std::max(int32_t(std::floor(std::min(a.y, b.y))), 0);
+			prim.nMaxX = std::min(int32_t(std::floor(std::max(a.x, b.x))) + 1, vFrameSize.x);
+			prim.nMaxY = std::min(int32_t(std::floor(std::max(a.y, b.y))) + 1, vFrameSize.y);
+			if (prim.nMinX >= prim.nMaxX || prim.nMinY >= prim.nMaxY) return;
+			vPrimitives.push_back(prim);
+			BinPrimitive(vPrimitives.back());
+		}
+
+		// Shade the pixels [x0, x1) of row "y" of a triangle. The attributes of 4 pixels at a time
+		// are stepped together, and opaque sprites are blended 4 pixels at a time too
+		void DrawSpan(const locPrimitive& prim, int32_t y, int32_t x0, int32_t x1)
+		{
+			olc::Pixel* pRow = vFrame.data() + size_t(y) * vFrameSize.x;
+			float fDX = float(x0) + 0.5f - prim.fOriginX, fDY = float(y) + 0.5f - prim.fOriginY;
+			float fStart[ATTR_COUNT];
+			for (int k = 0; k < ATTR_COUNT; k++) fStart[k] = prim.fPlane[k] + prim.fPlaneX[k] * fDX + prim.fPlaneY[k] * fDY;
+
+#if defined(__AVX__) || defined(__SSE2__) || defined(_M_X64)
+			const __m128 vLane = _mm_setr_ps(0.0f, 1.0f, 2.0f, 3.0f);
+			if (prim.bFast)
+			{
+				const locTexture* tex = prim.tex;
+				const __m128 vU = _mm_set1_ps(fStart[ATTR_U]), vStepU = _mm_set1_ps(prim.fPlaneX[ATTR_U]);
+				const __m128 vV = _mm_set1_ps(fStart[ATTR_V]), vStepV = _mm_set1_ps(prim.fPlaneX[ATTR_V]);
+				const __m128 vW = _mm_set1_ps(float(tex->nWidth)), vH = _mm_set1_ps(float(tex->nHeight));
+				const __m128 vMaxX = _mm_set1_ps(float(tex->nWidth - 1)), vMaxY = _mm_set1_ps(float(tex->nHeight - 1));
+				const __m128i vBlend = _mm_set1_epi16(256);
+				const olc::Pixel* pTex = tex->vPixels.data();
+				for (int32_t x = x0; x < x1; x += 4)
+				{
+					__m128 vI = _mm_add_ps(_mm_set1_ps(float(x - x0)), vLane);
+					// Clamped before truncating, which then rounds down, as NearestTexel() does.
+					// Taking the maximum with zero second also turns NaN into zero
+					__m128 fx = _mm_min_ps(_mm_max_ps(_mm_mul_ps(_mm_add_ps(vU, _mm_mul_ps(vI, vStepU)), vW), _mm_setzero_ps()), vMaxX);
+					__m128 fy = _mm_min_ps(_mm_max_ps(_mm_mul_ps(_mm_add_ps(vV, _mm_mul_ps(vI, vStepV)), vH), _mm_setzero_ps()), vMaxY);
+					// Row times width stays exact in a float, for textures under 2^24 texels
+					__m128 fRow = _mm_mul_ps(_mm_cvtepi32_ps(_mm_cvttps_epi32(fy)), vW);
+					alignas(16) int32_t nTexel[4];
+					_mm_store_si128(reinterpret_cast<__m128i*>(nTexel), _mm_add_epi32(_mm_cvttps_epi32(fRow), _mm_cvttps_epi32(fx)));
+					__m128i s = _mm_setr_epi32(int(pTex[nTexel[0]].n), int(pTex[nTexel[1]].n), int(pTex[nTexel[2]].n), int(pTex[nTexel[3]].n));
+
+					if (x + 4 <= x1)
+					{
+						__m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pRow + x));
+						_mm_storeu_si128(reinterpret_cast<__m128i*>(pRow + x), BlendPacked(s, d, vBlend));
+					}
+					else
+					{
+						// The last pixels go through a copy, so nothing past the span is touched
+						alignas(16) olc::Pixel pTail[4];
+						std::copy(pRow + x, pRow + x1, pTail);
+						__m128i d = _mm_load_si128(reinterpret_cast<const __m128i*>(pTail));
+						_mm_store_si128(reinterpret_cast<__m128i*>(pTail), BlendPacked(s, d, vBlend));
+						std::copy(pTail, pTail + (x1 - x), pRow + x);
+					}
+				}
+				return;
+			}
+
+			for (int32_t x = x0; x < x1; x += 4)
+			{
+				__m128 vI = _mm_add_ps(_mm_set1_ps(float(x - x0)), vLane);
+				alignas(16) float f[ATTR_COUNT][4];
+				for (int k = 0; k < ATTR_COUNT; k++)
+					_mm_store_ps(f[k], _mm_add_ps(_mm_set1_ps(fStart[k]), _mm_mul_ps(vI, _mm_set1_ps(prim.fPlaneX[k]))));
+				for (int i = 0; i < 4 && x + i < x1; i++)
+					ShadePixel(pRow[x + i], prim.tex, prim.mode, f[ATTR_U][i], f[ATTR_V][i], f[ATTR_W][i], f[ATTR_R][i], f[ATTR_G][i], f[ATTR_B][i], f[ATTR_A][i]);
+			}
+#else
+			for (int32_t x = x0; x < x1; x++)
+			{
+				float f[ATTR_COUNT];
+				for (int k = 0; k < ATTR_COUNT; k++) f[k] = fStart[k] + float(x - x0) * prim.fPlaneX[k];
+				ShadePixel(pRow[x], prim.tex, prim.mode, f[ATTR_U], f[ATTR_V], f[ATTR_W], f[ATTR_R], f[ATTR_G], f[ATTR_B], f[ATTR_A]);
+			}
 #endif
+		}
 
-#if defined(OLC_PLATFORM_EMSCRIPTEN)
-			eglMakeCurrent(olc_Display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
-			eglDestroyContext(olc_Display, olc_Context);
-			eglDestroySurface(olc_Display, olc_Surface);
-			eglTerminate(olc_Display);
-			olc_Display = EGL_NO_DISPLAY;
-			olc_Surface = EGL_NO_SURFACE;
-			olc_Context = EGL_NO_CONTEXT;
-#endif
-			return olc::rcode::OK;
+		// Draw the part of a triangle inside the pixels [x0, x1) x [y0, y1). Pixels whose centre is
+		// inside are drawn. Each row's run of them is found from the edge functions directly
+		void DrawTriangle(const locPrimitive& prim, int32_t x0, int32_t y0, int32_t x1, int32_t y1)
+		{
+			x0 = std::max(x0, prim.nMinX); x1 = std::min(x1, prim.nMaxX);
+			y0 = std::max(y0, prim.nMinY); y1 = std::min(y1, prim.nMaxY);
+			for (int32_t y = y0; y < y1; y++)
+			{
+				int64_t nLeft = x0, nRight = x1;
+				for (int k = 0; k < 3; k++)
+				{
+					// The edge function is nEdge + nEdgeX * x along this row, and must not be negative
+					int64_t e = prim.nEdge[k] + prim.nEdgeY[k] * y, s = prim.nEdgeX[k];
+					if (s > 0) nLeft = std::max(nLeft, -FloorDiv(e, s));
+					else if (s < 0) nRight = std::min(nRight, FloorDiv(e, -s) + 1);
+					else if (e < 0) nRight = nLeft;
+				}
+				if (nLeft < nRight) DrawSpan(prim, y, int32_t(nLeft), int32_t(nRight));
+			}
 		}
 
-		void DisplayFrame() override
+		// Draw the part of a wireframe edge inside the pixels [x0, x1) x [y0, y1), leaving out its
+		// last pixel so the corners of a line loop are drawn once
+		void DrawLine(const locPrimitive& prim, int32_t x0, int32_t y0, int32_t x1, int32_t y1)
 		{
-#if defined(OLC_PLATFORM_WINAPI)
-			SwapBuffers(glDeviceContext);
-			if (bSync) DwmFlush(); // Woooohooooooo!!!! SMOOOOOOOTH!
-#endif	
+			const locVertex& a = prim.a;
+			const locVertex& b = prim.b;
+			int32_t nSteps = std::max(int32_t(std::ceil(std::max(std::abs(b.x - a.x), std::abs(b.y - a.y)))), 1);
+			for (int32_t i = 0; i < nSteps; i++)
+			{
+				float t = float(i) / float(nSteps);
+				int32_t x = int32_t(std::floor(a.x + (b.x - a.x) * t));
+				int32_t y = int32_t(std::floor(a.y + (b.y - a.y) * t));
+				if (x < x0 || x >= x1 || y < y0 || y >= y1) continue;
+				auto Lerp = [t](float p, float q) { return p + (q - p) * t; };
+				ShadePixel(vFrame[size_t(y) * vFrameSize.x + x], prim.tex, olc::DecalMode::WIREFRAME, Lerp(a.u, b.u), Lerp(a.v, b.v),
+					Lerp(a.w, b.w), Lerp(a.r, b.r), Lerp(a.g, b.g), Lerp(a.b, b.b), Lerp(a.a, b.a));
+			}
+		}
 
-#if defined(OLC_PLATFORM_X11)
-			X11::glXSwapBuffers(olc_Display, *olc_Window);
-#endif		
+	public:
+		void SetThreads(int32_t n) override
+		{ nThreads = std::max(n, 0); }
 
-#if defined(OLC_PLATFORM_GLUT)
-			glutSwapBuffers();
-#endif
+		~Renderer_Software()
+		{ StopWorkers(); }
 
-#if defined(OLC_PLATFORM_EMSCRIPTEN)
-			eglSwapBuffers(olc_Display, olc_Surface);
-#endif
-		}
+		void PrepareDevice() override
+		{}
 
-		void PrepareDrawing() override
+		olc::rcode CreateDevice(std::vector<void*> params, bool bFullScreen, bool bVSYNC) override
 		{
-			glEnable(GL_BLEND);
-			nDecalMode = DecalMode::NORMAL;
-			glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-			locUseProgram(m_nQuadShader);
-			locBindVertexArray(m_vaQuad);
+			UNUSED(params);
+			UNUSED(bFullScreen);
+			UNUSED(bVSYNC);
+			StopWorkers();
+			int32_t nCount = nThreads > 0 ? nThreads : std::max(int32_t(std::thread::hardware_concurrency()), 1);
+			vThreadRows.assign(nCount, {});
+			for (int32_t i = 1; i < nCount; i++)
+				vWorkers.emplace_back(&Renderer_Software::JobWorker, this, i);
 
-#if defined(OLC_PLATFORM_EMSCRIPTEN)
-			locVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(locVertex), 0); locEnableVertexAttribArray(0);
-			locVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(locVertex), (void*)(3 * sizeof(float))); locEnableVertexAttribArray(1);
-			locVertexAttribPointer(2, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(locVertex), (void*)(5 * sizeof(float)));	locEnableVertexAttribArray(2);
-#endif
+			nFrameCount = 0;
+			nDecalCount = 0;
+			nTriangleCount = 0;
+			fSimulatedTime = 0.0;
+			fDrawTime = 0.0;
+			tpStart = std::chrono::steady_clock::now();
+			tpFrameStart = tpStart;
+			return olc::rcode::OK;
 		}
 
-		void SetDecalMode(const olc::DecalMode& mode) override
+		olc::rcode DestroyDevice() override
 		{
-			if (mode != nDecalMode)
-			{
-				switch (mode)
-				{
-				case olc::DecalMode::NORMAL: glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);	break;
-				case olc::DecalMode::ADDITIVE: glBlendFunc(GL_SRC_ALPHA, GL_ONE); break;
-				case olc::DecalMode::MULTIPLICATIVE: glBlendFunc(GL_DST_COLOR, GL_ONE_MINUS_SRC_ALPHA);	break;
-				case olc::DecalMode::STENCIL: glBlendFunc(GL_ZERO, GL_SRC_ALPHA); break;
-				case olc::DecalMode::ILLUMINATE: glBlendFunc(GL_ONE_MINUS_SRC_ALPHA, GL_SRC_ALPHA);	break;
-				case olc::DecalMode::WIREFRAME: glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);	break;
-				}
+			StopWorkers();
+			double fWall = GetWallTime();
+			printf("Software: %llu frames, %llu decals, %llu triangles, %.3fs simulated in %.3fs (%.0f fps, %.1fx real time), %.3fs drawing with %d threads\n",
+				(unsigned long long)nFrameCount, (unsigned long long)nDecalCount, (unsigned long long)nTriangleCount, fSimulatedTime, fWall,
+				fWall > 0.0 ? double(nFrameCount) / fWall : 0.0, fWall > 0.0 ? fSimulatedTime / fWall : 0.0, fDrawTime, int(vThreadRows.size()));
+			return olc::rcode::OK;
+		}
 
-				nDecalMode = mode;
-			}
+		void DisplayFrame() override
+		{
+			nFrameCount++;
+			fSimulatedTime += ptrPGE->GetElapsedTime();
+			fDrawTime += std::chrono::duration<double>(std::chrono::steady_clock::now() - tpFrameStart).count();
 		}
 
+		void PrepareDrawing() override
+		{}
+
+		void SetDecalMode(const olc::DecalMode& mode) override
+		{ UNUSED(mode); }
+
 		void DrawLayerQuad(const olc::vf2d& offset, const olc::vf2d& scale, const olc::Pixel tint) override
 		{
-			locBindBuffer(0x8892, m_vbQuad);
-			locVertex verts[4] = {
-				{{-1.0f, -1.0f, 1.0}, {0.0f * scale.x + offset.x, 1.0f * scale.y + offset.y}, tint},
-				{{+1.0f, -1.0f, 1.0}, {1.0f * scale.x + offset.x, 1.0f * scale.y + offset.y}, tint},
-				{{-1.0f, +1.0f, 1.0}, {0.0f * scale.x + offset.x, 0.0f * scale.y + offset.y}, tint},
-				{{+1.0f, +1.0f, 1.0}, {1.0f * scale.x + offset.x, 0.0f * scale.y + offset.y}, tint},
-			};
+			const locTexture* tex = FindTexture(nBoundTexture);
+			if (tex == nullptr || tex->vPixels.empty() || vFrame.empty()) return;
 
-			locBufferData(0x8892, sizeof(locVertex) * 4, verts, 0x88E0);
-			glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+			// The layer quad covers the frame, so each frame column reads the same texture column on every row.
+			// Layer textures are never filtered
+			vLayerColumns.resize(vFrameSize.x);
+			bool bDirect = vFrameSize.x == tex->nWidth;
+			for (int32_t x = 0; x < vFrameSize.x; x++)
+			{
+				vLayerColumns[x] = NearestTexel((offset.x + scale.x * (float(x) + 0.5f) / float(vFrameSize.x)) * tex->nWidth, tex->nWidth, tex->bClamp);
+				bDirect &= vLayerColumns[x] == x;
+			}
+			bool bTint = tint != olc::WHITE;
+
+			ParallelFor((vFrameSize.y + nJobRows - 1) / nJobRows, [&](int32_t nJob, int32_t nThread) {
+				std::vector<olc::Pixel>& vRow = vThreadRows[nThread];
+				vRow.resize(vFrameSize.x);
+				for (int32_t y = nJob * nJobRows; y < std::min(nJob * nJobRows + nJobRows, vFrameSize.y); y++)
+				{
+					int32_t sy = NearestTexel((offset.y + scale.y * (float(y) + 0.5f) / float(vFrameSize.y)) * tex->nHeight, tex->nHeight, tex->bClamp);
+					const olc::Pixel* pSrc = tex->vPixels.data() + size_t(sy) * tex->nWidth;
+					if (!bDirect || bTint)
+					{
+						for (int32_t x = 0; x < vFrameSize.x; x++)
+							vRow[x] = bTint ? Modulate(pSrc[vLayerColumns[x]], tint.r, tint.g, tint.b, tint.a) : pSrc[vLayerColumns[x]];
+						pSrc = vRow.data();
+					}
+					CompositeRow(vFrame.data() + size_t(y) * vFrameSize.x, pSrc, vFrameSize.x);
+				}
+			});
 		}
 
 		void DrawDecal(const olc::DecalInstance& decal) override
+		{ DrawDecals(&decal, 1); }
+
+		void DrawDecals(const olc::DecalInstance* decals, size_t count) override
 		{
-			SetDecalMode(decal.mode);
-			if (decal.decal == nullptr)
-				glBindTexture(GL_TEXTURE_2D, rendBlankQuad.Decal()->id);
-			else
-				glBindTexture(GL_TEXTURE_2D, decal.decal->id);
+			nDecalCount += count;
+			if (count == 0 || vFrame.empty()) return;
 
-			locBindBuffer(0x8892, m_vbQuad);
+			// Set up and bin every triangle first. The bins keep the order the decals were drawn in,
+			// so overlapping decals still blend in that order within each tile
+			vPrimitives.clear();
+			for (auto& bin : vTileBins) bin.clear();
+			for (size_t i = 0; i < count; i++)
+			{
+				const olc::DecalInstance& decal = decals[i];
+				if (decal.mode == olc::DecalMode::MODEL3D || decal.points == 0) continue;
+				const locTexture* tex = decal.decal == nullptr ? nullptr : FindTexture(uint32_t(decal.decal->id));
+				if (decal.mode == olc::DecalMode::WIREFRAME)
+				{
+					for (uint32_t n = 0; n < decal.points; n++)
+						AddLine(tex, ToFrame(decal, n), ToFrame(decal, (n + 1) % decal.points));
+					continue;
+				}
 
-			for (uint32_t i = 0; i < decal.points; i++)
-				pVertexMem[i] = { { decal.pos[i].x, decal.pos[i].y, decal.w[i] }, { decal.uv[i].x, decal.uv[i].y }, decal.tint[i] };
+				locVertex tri[3];
+				uint32_t k = 0;
+				ForEachBatchedVertex(decal, [&](uint32_t n) {
+					tri[k++] = ToFrame(decal, n);
+					if (k < 3) return;
+					AddTriangle(tex, decal.mode, &tri[0], &tri[1], &tri[2]);
+					nTriangleCount++;
+					k = 0;
+				});
+			}
 
-			locBufferData(0x8892, sizeof(locVertex) * decal.points, pVertexMem, 0x88E0);
+			vActiveTiles.clear();
+			for (int32_t i = 0; i < int32_t(vTileBins.size()); i++)
+				if (!vTileBins[i].empty()) vActiveTiles.push_back(i);
 
-			if (nDecalMode == DecalMode::WIREFRAME)
-				glDrawArrays(GL_LINE_LOOP, 0, decal.points);
-			else
-				glDrawArrays(GL_TRIANGLE_FAN, 0, decal.points);
+			ParallelFor(int32_t(vActiveTiles.size()), [&](int32_t nJob, int32_t) {
+				int32_t nTile = vActiveTiles[nJob];
+				int32_t x0 = (nTile % vTiles.x) * nTileSize, y0 = (nTile / vTiles.x) * nTileSize;
+				int32_t x1 = std::min(x0 + nTileSize, vFrameSize.x), y1 = std::min(y0 + nTileSize, vFrameSize.y);
+				for (uint32_t nPrim : vTileBins[nTile])
+				{
+					const locPrimitive& prim = vPrimitives[nPrim];
+					if (prim.bLine) DrawLine(prim, x0, y0, x1, y1);
+					else DrawTriangle(prim, x0, y0, x1, y1);
+				}
+			});
 		}
 
 		uint32_t CreateTexture(const uint32_t width, const uint32_t height, const bool filtered, const bool clamp) override
 		{
-			UNUSED(width);
-			UNUSED(height);
-			uint32_t id = 0;
-			glGenTextures(1, &id);
-			glBindTexture(GL_TEXTURE_2D, id);
-
-			if (filtered)
-			{
-				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-			}
-			else
-			{
-				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-			}
+			// Reuse the slot of a deleted texture
+			size_t i = 0;
+			while (i < vTextures.size() && vTextures[i].bUsed) i++;
+			if (i == vTextures.size()) vTextures.emplace_back();
+			locTexture& tex = vTextures[i];
+			tex.nWidth = int32_t(width);
+			tex.nHeight = int32_t(height);
+			tex.bFiltered = filtered;
+			tex.bClamp = clamp;
+			tex.bUsed = true;
+			tex.vPixels.assign(size_t(width) * size_t(height), olc::BLANK);
+			return uint32_t(i + 1);
+		}
 
-			if (clamp)
-			{
-				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP);
-				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP);
-			}
-			else
+		uint32_t DeleteTexture(const uint32_t id) override
+		{
+			if (locTexture* tex = FindTexture(id))
 			{
-				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+				tex->bUsed = false;
+				std::vector<olc::Pixel>().swap(tex->vPixels);
 			}
-#if !defined(OLC_PLATFORM_EMSCRIPTEN)
-			glTexEnvf(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_MODULATE);
-#endif
 			return id;
 		}
 
-		uint32_t DeleteTexture(const uint32_t id) override
+		void UpdateTexture(uint32_t id, olc::Sprite* spr) override
 		{
-			glDeleteTextures(1, &id);
-			return id;
+			locTexture* tex = FindTexture(id);
+			if (tex == nullptr) return;
+			tex->nWidth = spr->width;
+			tex->nHeight = spr->height;
+			tex->vPixels.assign(spr->GetData(), spr->GetData() + size_t(spr->width) * size_t(spr->height));
 		}
 
-		void UpdateTexture(uint32_t id, olc::Sprite* spr) override
+		void UpdateTextureRows(uint32_t id, olc::Sprite* spr, int32_t y0, int32_t y1) override
 		{
-			UNUSED(id);
-			glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, spr->width, spr->height, 0, GL_RGBA, GL_UNSIGNED_BYTE, spr->GetData());
+			locTexture* tex = FindTexture(id);
+			if (tex == nullptr) return;
+			if (tex->nWidth != spr->width || tex->nHeight != spr->height) { UpdateTexture(id, spr); return; }
+			if (y1 <= y0) return;
+			ParallelFor((y1 - y0 + nJobRows - 1) / nJobRows, [&](int32_t nJob, int32_t) {
+				int32_t nTop = y0 + nJob * nJobRows, nBottom = std::min(nTop + nJobRows, y1);
+				std::memcpy(tex->vPixels.data() + size_t(nTop) * tex->nWidth, spr->GetData() + size_t(nTop) * spr->width, sizeof(olc::Pixel) * size_t(spr->width) * (nBottom - nTop));
+			});
 		}
 
 		void ReadTexture(uint32_t id, olc::Sprite* spr) override
 		{
-			glReadPixels(0, 0, spr->width, spr->height, GL_RGBA, GL_UNSIGNED_BYTE, spr->GetData());
+			const locTexture* tex = FindTexture(id);
+			if (tex == nullptr) return;
+			int32_t w = std::min(tex->nWidth, spr->width), h = std::min(tex->nHeight, spr->height);
+			for (int32_t y = 0; y < h; y++)
+				std::memcpy(spr->GetData() + size_t(y) * spr->width, tex->vPixels.data() + size_t(y) * tex->nWidth, sizeof(olc::Pixel) * w);
+			spr->MarkDirty(0, h);
 		}
 
-		void ApplyTexture(uint32_t id) override
+		bool BeginFrameRead() override
 		{
-			glBindTexture(GL_TEXTURE_2D, id);
+			if (nReadCount == nFrameReads || vFrame.empty()) return false;
+			locFrameRead& read = vReads[(nFirstRead + nReadCount) % nFrameReads];
+			nReadCount++;
+			read.vSize = vFrameSize;
+			read.vPixels.assign(vFrame.begin(), vFrame.end());
+			return true;
+		}
+
+		bool EndFrameRead(olc::Sprite* spr, bool bWait) override
+		{
+			// Frames are copied when they are queued, so there is never anything to wait for
+			UNUSED(bWait);
+			if (nReadCount == 0) return false;
+			locFrameRead& read = vReads[nFirstRead];
+			nFirstRead = (nFirstRead + 1) % nFrameReads;
+			nReadCount--;
+
+			// The sprite's old pixels are kept for a later read
+			spr->width = read.vSize.x;
+			spr->height = read.vSize.y;
+			std::swap(spr->pColData, read.vPixels);
+			spr->MarkDirty();
+			return true;
 		}
 
+		void ApplyTexture(uint32_t id) override
+		{ nBoundTexture = id; }
+
 		void ClearBuffer(olc::Pixel p, bool bDepth) override
 		{
-			glClearColor(float(p.r) / 255.0f, float(p.g) / 255.0f, float(p.b) / 255.0f, float(p.a) / 255.0f);
-			glClear(GL_COLOR_BUFFER_BIT);
-			if (bDepth) glClear(GL_DEPTH_BUFFER_BIT);
+			UNUSED(bDepth);
+			// Every frame starts with a clear
+			tpFrameStart = std::chrono::steady_clock::now();
+			ParallelFor((vFrameSize.y + nJobRows - 1) / nJobRows, [&](int32_t nJob, int32_t) {
+				int32_t nTop = nJob * nJobRows, nBottom = std::min(nTop + nJobRows, vFrameSize.y);
+				FillPixels(vFrame.data() + size_t(nTop) * vFrameSize.x, size_t(nBottom - nTop) * vFrameSize.x, p, true);
+			});
 		}
 
 		void UpdateViewport(const olc::vi2d& pos, const olc::vi2d& size) override
 		{
-			glViewport(pos.x, pos.y, size.x, size.y);
+			// The frame is the viewport alone, with its top row first
+			UNUSED(pos);
+			vFrameSize = { std::max(size.x, 0), std::max(size.y, 0) };
+			vFrame.resize(size_t(vFrameSize.x) * size_t(vFrameSize.y), olc::BLACK);
+			vTiles = { (vFrameSize.x + nTileSize - 1) / nTileSize, (vFrameSize.y + nTileSize - 1) / nTileSize };
+			vTileBins.resize(size_t(vTiles.x) * size_t(vTiles.y));
 		}
+
+	public:
+		// The last frame drawn, top row first, valid until the next frame starts
+		const olc::Pixel* GetFrame() const
+		{ return vFrame.data(); }
+
+		const olc::vi2d& GetFrameSize() const
+		{ return vFrameSize; }
+
+		// Frames presented since the device was created
+		uint64_t GetFrameCount() const
+		{ return nFrameCount; }
+
+		// Decal instances drawn since the device was created
+		uint64_t GetDecalCount() const
+		{ return nDecalCount; }
+
+		// Triangles drawn since the device was created
+		uint64_t GetTriangleCount() const
+		{ return nTriangleCount; }
+
+		// Sum of the elapsed times handed to the application
+		double GetSimulatedTime() const
+		{ return fSimulatedTime; }
+
+		// Real seconds spent drawing frames, from each clear to its display
+		double GetDrawTime() const
+		{ return fDrawTime; }
+
+		// Real seconds since the device was created
+		double GetWallTime() const
+		{ return std::chrono::duration<double>(std::chrono::steady_clock::now() - tpStart).count(); }
 	};
 }
 #endif
 // O------------------------------------------------------------------------------O
-// | END RENDERER: OpenGL 3.3 (3.0 es) (sh-sh-sh-shaders....)                     |
+// | END RENDERER: Software                                                       |
 // O------------------------------------------------------------------------------O
 #pragma endregion
 
@@ -4559,6 +6363,8 @@ namespace olc
 // | olcPixelGameEngine Platforms                                                 |
 // O------------------------------------------------------------------------------O
 
+#if !defined(OLC_PGE_HEADLESS)
+
 #pragma region platform_windows
 // O------------------------------------------------------------------------------O
 // | START PLATFORM: MICROSOFT WINDOWS XP, VISTA, 7, 8, 10                        |
@@ -5771,6 +7577,70 @@ extern "C"
 
 #endif // Headless
 
+#pragma region platform_headless
+// O------------------------------------------------------------------------------O
+// | START PLATFORM: Headless (no window, no events, no display required)         |
+// O------------------------------------------------------------------------------O
+#if defined(OLC_PGE_HEADLESS) && !defined(OLC_PLATFORM_CUSTOM_EX)
+namespace olc
+{
+	class Platform_Headless : public olc::Platform
+	{
+	public:
+		virtual olc::rcode ApplicationStartUp() override
+		{ return olc::rcode::OK; }
+
+		virtual olc::rcode ApplicationCleanUp() override
+		{ return olc::rcode::OK; }
+
+		virtual olc::rcode ThreadStartUp() override
+		{ return olc::rcode::OK; }
+
+		virtual olc::rcode ThreadCleanUp() override
+		{
+			renderer->DestroyDevice();
+			return olc::OK;
+		}
+
+		virtual olc::rcode CreateGraphics(bool bFullScreen, bool bEnableVSYNC, const olc::vi2d& vViewPos, const olc::vi2d& vViewSize) override
+		{
+			if (renderer->CreateDevice({}, bFullScreen, bEnableVSYNC) == olc::rcode::OK)
+			{
+				renderer->UpdateViewport(vViewPos, vViewSize);
+				return olc::rcode::OK;
+			}
+			else
+				return olc::rcode::FAIL;
+		}
+
+		virtual olc::rcode CreateWindowPane(const olc::vi2d& vWindowPos, olc::vi2d& vWindowSize, bool bFullScreen) override
+		{
+			// There is no window, so the requested size is always granted
+			UNUSED(vWindowPos);
+			UNUSED(vWindowSize);
+			UNUSED(bFullScreen);
+			return olc::rcode::OK;
+		}
+
+		virtual olc::rcode SetWindowTitle(const std::string& s) override
+		{
+			UNUSED(s);
+			return olc::rcode::OK;
+		}
+
+		virtual olc::rcode StartSystemEventLoop() override
+		{ return olc::rcode::OK; }
+
+		virtual olc::rcode HandleSystemEvent() override
+		{ return olc::rcode::OK; }
+	};
+}
+#endif
+// O------------------------------------------------------------------------------O
+// | END PLATFORM: Headless                                                       |
+// O------------------------------------------------------------------------------O
+#pragma endregion
+
 // O------------------------------------------------------------------------------O
 // | olcPixelGameEngine Auto-Configuration                                        |
 // O------------------------------------------------------------------------------O
@@ -5780,8 +7650,6 @@ namespace olc
 	void PixelGameEngine::olc_ConfigureSystem()
 	{
 
-#if !defined(OLC_PGE_HEADLESS)
-
 #if defined(OLC_IMAGE_GDI)
 		olc::Sprite::loader = std::make_unique<olc::ImageLoader_GDIPlus>();
 #endif
@@ -5799,7 +7667,7 @@ namespace olc
 #endif
 
 
-
+#if !defined(OLC_PGE_HEADLESS)
 
 #if defined(OLC_PLATFORM_WINAPI)
 		platform = std::make_unique<olc::Platform_Windows>();
@@ -5845,16 +7713,29 @@ namespace olc
 
 #if defined(OLC_GFX_CUSTOM_EX)
 		renderer = std::make_unique<OLC_RENDERER_CUSTOM_EX>();
+#endif
+
+#else
+
+#if defined(OLC_PLATFORM_CUSTOM_EX)
+		platform = std::make_unique<OLC_PLATFORM_CUSTOM_EX>();
+#else
+		platform = std::make_unique<olc::Platform_Headless>();
+#endif
+
+#if defined(OLC_GFX_CUSTOM_EX)
+		renderer = std::make_unique<OLC_RENDERER_CUSTOM_EX>();
+#elif defined(OLC_GFX_SOFTWARE)
+		renderer = std::make_unique<olc::Renderer_Software>();
+#else
+		renderer = std::make_unique<olc::Renderer_Headless>();
+#endif
+
 #endif
 
 		// Associate components with PGE instance
 		platform->ptrPGE = this;
 		renderer->ptrPGE = this;
-#else
-		olc::Sprite::loader = nullptr;
-		platform = nullptr;
-		renderer = nullptr;
-#endif
 	}
 }
 
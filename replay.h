@@ -0,0 +1,150 @@
+// Alex Eidt
+// Dino Game - Replays
+
+// Records the input delivered to each simulation step so a game can be played back exactly.
+// The simulation is deterministic given its seed, so the seed and the steps that received a key
+// press are all a replay needs to store.
+//
+// File layout (all integers are unsigned LEB128 varints unless noted):
+//     "DINO" magic, 1 byte version, 8 byte little endian seed
+//     Records: step delta since the previous record, 1 byte of REPLAY_* input flags (never 0)
+//     Footer: step delta, a 0 flags byte, final score, final max score
+
+#pragma once
+
+#include <cstdint>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+
+#include "dino.h"
+
+#define REPLAY_VERSION 2 // Raised whenever the game rules change, since older replays would no longer play back.
+
+// Replay input flags.
+#define REPLAY_JUMP 1
+#define REPLAY_DUCK 2
+#define REPLAY_STAND 4
+
+namespace dino {
+	class Recorder {
+	public:
+		~Recorder() {
+			if (file.is_open()) file.close();
+		}
+
+		void Open(const std::string& path, uint64_t seed) {
+			file.open(path, std::ios::binary);
+			if (!file.is_open()) throw std::runtime_error("Failed to open replay for writing: " + path);
+			file.write("DINO", 4);
+			file.put(char(REPLAY_VERSION));
+			for (int i = 0; i < 8; i++) file.put(char(seed >> (8 * i)));
+			lastStep = 0;
+		}
+
+		bool IsOpen() const {
+			return file.is_open();
+		}
+
+		// Record the input delivered to "step". Steps without a key press take no space.
+		void Record(uint64_t step, const Input& input) {
+			uint8_t flags = (input.jump ? REPLAY_JUMP : 0) | (input.duck ? REPLAY_DUCK : 0) | (input.stand ? REPLAY_STAND : 0);
+			if (!file.is_open() || flags == 0) return;
+			WriteVarint(step - lastStep);
+			file.put(char(flags));
+			lastStep = step;
+		}
+
+		// Write the footer. "steps" is the number of steps simulated, the score is used to verify playback.
+		void Close(uint64_t steps, int score, int maxScore) {
+			if (!file.is_open()) return;
+			WriteVarint(steps - lastStep);
+			file.put(0);
+			WriteVarint(uint64_t(score));
+			WriteVarint(uint64_t(maxScore));
+			file.close();
+		}
+
+	private:
+		std::ofstream file;
+		uint64_t lastStep = 0;
+
+		void WriteVarint(uint64_t value) {
+			while (value >= 0x80) {
+				file.put(char((value & 0x7F) | 0x80));
+				value >>= 7;
+			}
+			file.put(char(value));
+		}
+	};
+
+	class Replay {
+	public:
+		uint64_t seed = 0;
+		uint64_t steps = 0; // Number of steps in the recorded game.
+		int score = 0; // Score at the end of the recorded game.
+		int maxScore = 0;
+
+		// Read a whole replay into memory.
+		void Load(const std::string& path) {
+			std::ifstream file(path, std::ios::binary);
+			if (!file.is_open()) throw std::runtime_error("Failed to open replay: " + path);
+			data.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+			cursor = 0;
+
+			if (data.size() < 13 || data.compare(0, 4, "DINO") != 0) throw std::runtime_error("Not a replay file: " + path);
+			if (uint8_t(data[4]) != REPLAY_VERSION) throw std::runtime_error("Unsupported replay version: " + path);
+			seed = 0;
+			for (int i = 0; i < 8; i++) seed |= uint64_t(uint8_t(data[5 + i])) << (8 * i);
+			cursor = 13;
+
+			// Walk the records once to find the footer and check the file is complete.
+			uint64_t step = 0;
+			while (true) {
+				step += ReadVarint();
+				if (ReadByte() == 0) break;
+			}
+			steps = step;
+			score = int(ReadVarint());
+			maxScore = int(ReadVarint());
+
+			cursor = 13;
+			nextStep = ReadVarint();
+			nextFlags = ReadByte();
+		}
+
+		// Input for "step". Steps must be requested in order, starting from 0.
+		Input InputAt(uint64_t step) {
+			Input input;
+			if (nextFlags == 0 || step != nextStep) return input;
+			input.jump = nextFlags & REPLAY_JUMP;
+			input.duck = nextFlags & REPLAY_DUCK;
+			input.stand = nextFlags & REPLAY_STAND;
+			nextStep += ReadVarint();
+			nextFlags = ReadByte();
+			return input;
+		}
+
+	private:
+		std::string data;
+		size_t cursor = 0;
+		uint64_t nextStep = 0;
+		uint8_t nextFlags = 0;
+
+		uint8_t ReadByte() {
+			if (cursor >= data.size()) throw std::runtime_error("Replay file is truncated");
+			return uint8_t(data[cursor++]);
+		}
+
+		uint64_t ReadVarint() {
+			uint64_t value = 0;
+			for (int shift = 0; shift < 64; shift += 7) {
+				uint8_t byte = ReadByte();
+				value |= uint64_t(byte & 0x7F) << shift;
+				if (!(byte & 0x80)) return value;
+			}
+			throw std::runtime_error("Replay file is corrupt");
+		}
+	};
+}
@@ -0,0 +1,140 @@
+// Alex Eidt
+// Dino Game - Sprites
+
+// Every sprite the game uses, with its size and its place in "sprites/sprites.png". The set of
+// sprites is fixed, so the table is built at compile time. The game checks it against the files
+// it loads at startup.
+
+#pragma once
+
+#define SHEET_WIDTH 2404
+#define SHEET_HEIGHT 130
+
+namespace dino {
+	// Sprites, in the sorted order of the files in the "sprites" directory.
+	enum Sprite : int {
+		SPRITE_0,
+		SPRITE_1,
+		SPRITE_2,
+		SPRITE_3,
+		SPRITE_4,
+		SPRITE_5,
+		SPRITE_6,
+		SPRITE_7,
+		SPRITE_8,
+		SPRITE_9,
+		SPRITE_H,
+		SPRITE_I,
+		SPRITE_ARROW,
+		SPRITE_CACTUS_1,
+		SPRITE_CACTUS_2,
+		SPRITE_CACTUS_3,
+		SPRITE_CACTUS_4,
+		SPRITE_CACTUS_5,
+		SPRITE_CACTUS_6,
+		SPRITE_CACTUS_7,
+		SPRITE_CACTUS_8,
+		SPRITE_CACTUS_9,
+		SPRITE_CLOUD,
+		SPRITE_DINO_0,
+		SPRITE_DINO_1,
+		SPRITE_DINO_2,
+		SPRITE_DINO_3,
+		SPRITE_DINO_4,
+		SPRITE_DINO_5,
+		SPRITE_DINO_6,
+		SPRITE_DINO_7,
+		SPRITE_DINO_8,
+		SPRITE_GAMEOVER,
+		SPRITE_GROUND,
+		SPRITE_PTERANODON_1,
+		SPRITE_PTERANODON_2,
+		SPRITE_SHEET,
+		SPRITE_COUNT
+	};
+
+	struct Rect {
+		int x;
+		int y;
+		int width;
+		int height;
+	};
+
+	struct SpriteInfo {
+		const char* name; // File name in the "sprites" directory.
+		int width;
+		int height;
+		int sheetX; // Top left corner in the sprite sheet.
+		int sheetY;
+		float u0; // Texture coordinates of the sprite in the sprite sheet.
+		float v0;
+		float u1;
+		float v1;
+		Rect hitbox; // Area that collides, relative to the top left of the sprite.
+	};
+
+	constexpr SpriteInfo MakeSprite(const char* name, int x, int y, int width, int height) {
+		return {
+			name, width, height, x, y,
+			float(x) / SHEET_WIDTH, float(y) / SHEET_HEIGHT,
+			float(x + width) / SHEET_WIDTH, float(y + height) / SHEET_HEIGHT,
+			{0, 0, width, height}
+		};
+	}
+
+	constexpr SpriteInfo SPRITE_INFO[SPRITE_COUNT] = {
+		//         File                     x    y    w    h
+		MakeSprite("0.png",               952,   2,   20,  21),
+		MakeSprite("1.png",               972,   2,   20,  21),
+		MakeSprite("2.png",               992,   2,   20,  21),
+		MakeSprite("3.png",              1012,   2,   20,  21),
+		MakeSprite("4.png",              1032,   2,   20,  21),
+		MakeSprite("5.png",              1052,   2,   20,  21),
+		MakeSprite("6.png",              1072,   2,   20,  21),
+		MakeSprite("7.png",              1092,   2,   20,  21),
+		MakeSprite("8.png",              1112,   2,   20,  21),
+		MakeSprite("9.png",              1132,   2,   20,  21),
+		MakeSprite("H.png",              1152,   2,   20,  21),
+		MakeSprite("I.png",              1172,   2,   20,  21),
+		MakeSprite("arrow.png",             2,   2,   72,  64),
+		MakeSprite("cactus_1.png",        446,   2,   34,  70),
+		MakeSprite("cactus_2.png",        514,   2,   34,  70),
+		MakeSprite("cactus_3.png",        548,   2,   34,  70),
+		MakeSprite("cactus_4.png",        582,   2,   34,  70),
+		MakeSprite("cactus_5.png",        616,   2,   34,  70),
+		MakeSprite("cactus_6.png",        652,   2,   50, 100),
+		MakeSprite("cactus_7.png",        702,   2,   48, 100),
+		MakeSprite("cactus_8.png",        752,   2,   50, 100),
+		MakeSprite("cactus_9.png",        802,   2,  150, 100),
+		MakeSprite("cloud.png",           166,   2,   92,  27),
+		MakeSprite("dino_0.png",           76,   4,   88,  94),
+		MakeSprite("dino_1.png",         1338,   2,   88,  94),
+		MakeSprite("dino_2.png",         1426,   2,   88,  94),
+		MakeSprite("dino_3.png",         1514,   2,   88,  94),
+		MakeSprite("dino_4.png",         1602,   2,   88,  94),
+		MakeSprite("dino_5.png",         1690,   2,   88,  94),
+		MakeSprite("dino_6.png",         1778,   2,   88,  94),
+		MakeSprite("dino_7.png",         1866,  36,  118,  60),
+		MakeSprite("dino_8.png",         1984,  36,  118,  60),
+		MakeSprite("gameover.png",        954,  29,  380,  21),
+		MakeSprite("ground.png",            2, 104, 2400,  26),
+		MakeSprite("pteranodon_1.png",    260,   2,   92,  80),
+		MakeSprite("pteranodon_2.png",    352,   2,   92,  80),
+		MakeSprite("sprites.png",           0,   0, 2404, 130)
+	};
+
+	constexpr const SpriteInfo& Info(int sprite) {
+		return SPRITE_INFO[sprite];
+	}
+
+	// Enemies are stored and tested by their full sprite rectangle.
+	constexpr bool CollidesWithFullSprite(int first, int last) {
+		for (int i = first; i <= last; i++) {
+			const Rect& box = SPRITE_INFO[i].hitbox;
+			if (box.x != 0 || box.y != 0 || box.width != SPRITE_INFO[i].width || box.height != SPRITE_INFO[i].height) return false;
+		}
+		return true;
+	}
+	static_assert(CollidesWithFullSprite(SPRITE_CACTUS_1, SPRITE_CACTUS_9), "Cactus hitboxes must cover the sprite");
+	static_assert(CollidesWithFullSprite(SPRITE_PTERANODON_1, SPRITE_PTERANODON_2), "Pteranodon hitboxes must cover the sprite");
+}
@@ -0,0 +1,259 @@
+// Alex Eidt
+// Dino Game - Batched Environments
+
+// Steps many independent games in lockstep for training agents. Per game state is stored as a
+// struct of arrays, and the games are split between a pool of worker threads that lives as long
+// as the environment. Every game follows the spawn, jump and collision rules in "dino.h".
+//
+// Each call to Step takes one action per game, applies it for "repeat" simulation steps, and
+// writes an observation, a done flag and the current score for each game. A game that ends is
+// reset immediately, so its observation is already the first of the next episode. Clouds, the
+// idle animation and the score blinking are left out as they have no effect on play.
+
+#pragma once
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "dino.h"
+
+#define OBSERVED_ENEMIES 2 // Number of upcoming enemies in each observation.
+#define OBSERVATION_SIZE (3 + 4 * OBSERVED_ENEMIES)
+
+namespace dino {
+	enum Action : uint8_t {
+		ACTION_NONE = 0,
+		ACTION_JUMP = 1,
+		ACTION_DUCK = 2
+	};
+
+	class VecEnv {
+	public:
+		// "threads" of 0 uses one thread per hardware thread.
+		VecEnv(const World& world, int count, uint64_t seed, int repeat = 4, int threads = 0)
+			: world(world), count(count), repeat(std::max(repeat, 1)) {
+			jumpTimer.resize(count);
+			jumpHeight.resize(count);
+			groundSpeed.resize(count);
+			isJumping.resize(count);
+			isDucking.resize(count);
+			dinoIndex.resize(count);
+			animationStep.resize(count);
+			flapStep.resize(count);
+			score.resize(count);
+			enemies.resize(count);
+			rng.resize(count);
+			observations.resize(size_t(count) * OBSERVATION_SIZE);
+			dones.resize(count);
+			scores.resize(count);
+
+			for (int i = 0; i < count; i++) {
+				rng[i].Seed(seed + i);
+			}
+			Reset();
+
+			if (threads <= 0) threads = std::max(int(std::thread::hardware_concurrency()), 1);
+			chunks = std::max(std::min(threads, count), 1);
+			// The calling thread works on the first chunk itself.
+			for (int i = 1; i < chunks; i++) {
+				workers.emplace_back(&VecEnv::Worker, this, i);
+			}
+		}
+
+		~VecEnv() {
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				quit = true;
+			}
+			wake.notify_all();
+			for (auto& worker : workers) worker.join();
+		}
+
+		VecEnv(const VecEnv&) = delete;
+		VecEnv& operator=(const VecEnv&) = delete;
+
+		int Count() const {
+			return count;
+		}
+
+		// Start a new episode in every game.
+		void Reset() {
+			for (int i = 0; i < count; i++) {
+				ResetGame(i);
+				Observe(i);
+				dones[i] = 0;
+				scores[i] = 0;
+			}
+		}
+
+		// Apply one "Action" per game. Blocks until every game has been stepped.
+		void Step(const uint8_t* actions) {
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				this->actions = actions;
+				pending = chunks - 1;
+				generation++;
+			}
+			wake.notify_all();
+
+			RunChunk(0);
+
+			std::unique_lock<std::mutex> lock(mutex);
+			finished.wait(lock, [this] { return pending == 0; });
+		}
+
+		// OBSERVATION_SIZE floats per game, all roughly in [0, 1]:
+		//     jump height, ducking, ground speed, then for each of the next OBSERVED_ENEMIES enemies
+		//     the distance to the dino, y, width and height. Missing enemies read as (1, 0, 0, 0).
+		const float* Observations() const {
+			return observations.data();
+		}
+
+		// 1 for each game that ended during the last step.
+		const uint8_t* Dones() const {
+			return dones.data();
+		}
+
+		// Score of each game, or the final score for games that just ended.
+		const int* Scores() const {
+			return scores.data();
+		}
+
+	private:
+		World world;
+		int count;
+		int repeat;
+
+		std::vector<float> jumpTimer;
+		std::vector<float> jumpHeight;
+		std::vector<float> groundSpeed;
+		std::vector<uint8_t> isJumping;
+		std::vector<uint8_t> isDucking;
+		std::vector<int> dinoIndex;
+		std::vector<int> animationStep;
+		std::vector<int> flapStep;
+		std::vector<int> score;
+		std::vector<EnemyList> enemies;
+		std::vector<Random> rng;
+
+		std::vector<float> observations;
+		std::vector<uint8_t> dones;
+		std::vector<int> scores;
+
+		// Worker pool.
+		int chunks = 1;
+		std::vector<std::thread> workers;
+		std::mutex mutex;
+		std::condition_variable wake;
+		std::condition_variable finished;
+		uint64_t generation = 0;
+		int pending = 0;
+		bool quit = false;
+		const uint8_t* actions = nullptr;
+
+		void Worker(int chunk) {
+			uint64_t seen = 0;
+			while (true) {
+				{
+					std::unique_lock<std::mutex> lock(mutex);
+					wake.wait(lock, [&] { return quit || generation != seen; });
+					if (quit) return;
+					seen = generation;
+				}
+
+				RunChunk(chunk);
+
+				std::lock_guard<std::mutex> lock(mutex);
+				if (--pending == 0) finished.notify_one();
+			}
+		}
+
+		void RunChunk(int chunk) {
+			int begin = int(int64_t(count) * chunk / chunks);
+			int end = int(int64_t(count) * (chunk + 1) / chunks);
+			for (int i = begin; i < end; i++) {
+				dones[i] = 0;
+				for (int r = 0; r < repeat && !dones[i]; r++) {
+					dones[i] = StepGame(i, actions[i]);
+				}
+				scores[i] = score[i];
+				if (dones[i]) ResetGame(i);
+				Observe(i);
+			}
+		}
+
+		void ResetGame(int i) {
+			jumpTimer[i] = 0.0f;
+			jumpHeight[i] = 0.0f;
+			groundSpeed[i] = GROUND_SPEED;
+			isJumping[i] = 0;
+			isDucking[i] = 0;
+			dinoIndex[i] = 3;
+			animationStep[i] = 0;
+			flapStep[i] = 0;
+			score[i] = 0;
+			enemies[i].clear();
+		}
+
+		// One STEP_TIME step of game "i", in the same order as Simulation::Step. Returns whether the game ended.
+		bool StepGame(int i, uint8_t action) {
+			groundSpeed[i] = std::min(groundSpeed[i] + STEP_TIME, MAX_GROUND_SPEED);
+			StepEnemies(world, rng[i], enemies[i], flapStep[i], STEP_TIME, groundSpeed[i], score[i]);
+
+			if (++animationStep[i] >= ANIMATION_STEPS) {
+				animationStep[i] = 0;
+				if (isJumping[i]) {
+					dinoIndex[i] = 1;
+				} else if (isDucking[i]) {
+					dinoIndex[i] = dinoIndex[i] == 7 ? 8 : 7;
+				} else {
+					dinoIndex[i] = dinoIndex[i] == 3 ? 4 : 3;
+				}
+				score[i]++;
+			}
+
+			jumpHeight[i] = JumpHeight(dinoIndex[i], jumpTimer[i]);
+
+			// Like key presses in the game, the action takes effect after this step's animation.
+			if (action == ACTION_JUMP) isJumping[i] = 1;
+			if (isJumping[i]) {
+				jumpTimer[i] += STEP_TIME;
+				if (jumpTimer[i] > JUMP_DURATION) {
+					isJumping[i] = 0;
+					jumpTimer[i] = 0.0f;
+				}
+			}
+			isDucking[i] = action == ACTION_DUCK;
+
+			return Collides(world, dinoIndex[i], jumpHeight[i], enemies[i]);
+		}
+
+		void Observe(int i) {
+			float* obs = &observations[size_t(i) * OBSERVATION_SIZE];
+			obs[0] = jumpHeight[i] / world.screenHeight;
+			obs[1] = isDucking[i];
+			obs[2] = groundSpeed[i] / MAX_GROUND_SPEED;
+
+			const EnemyList& list = enemies[i];
+			int seen = 0;
+			for (int k = 0; k < list.size() && seen < OBSERVED_ENEMIES; k++) {
+				int j = list.Slot(k);
+				if (list.x[j] + list.width[j] < PLAYER_POSITION) continue; // Already passed.
+				float* e = obs + 3 + 4 * seen++;
+				e[0] = (list.x[j] - PLAYER_POSITION) / world.screenWidth;
+				e[1] = list.y[j] / world.screenHeight;
+				e[2] = list.width[j] / world.screenWidth;
+				e[3] = list.height[j] / world.screenHeight;
+			}
+			for (; seen < OBSERVED_ENEMIES; seen++) {
+				float* e = obs + 3 + 4 * seen;
+				e[0] = 1.0f;
+				e[1] = e[2] = e[3] = 0.0f;
+			}
+		}
+	};
+}